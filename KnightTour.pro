@@ -1,29 +1,12 @@
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-CONFIG += c++17
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    chessboard.cpp \
-    main.cpp \
-    mainwindow.cpp
-
-HEADERS += \
-    chessboard.h \
-    mainwindow.h
-
-FORMS += \
-    mainwindow.ui
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-
-RESOURCES += \
-    resources.qrc
+TEMPLATE = subdirs
+
+# engine：无界面的巡游求解静态库；app：Qt 图形界面；bench：求解器基准测试；tests：引擎自检
+SUBDIRS += \
+    engine \
+    app \
+    bench \
+    tests
+
+app.depends = engine
+bench.depends = engine
+tests.depends = engine
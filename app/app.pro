@@ -0,0 +1,44 @@
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+QT += concurrent
+
+CONFIG += c++17
+
+TARGET = KnightTour
+
+# 求解引擎静态库
+include(../engine/engine.pri)
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    chessboard.cpp \
+    densitypyramid.cpp \
+    main.cpp \
+    mainwindow.cpp \
+    pathchunkindex.cpp \
+    pathspatialindex.cpp \
+    playbackclock.cpp
+
+HEADERS += \
+    chessboard.h \
+    densitypyramid.h \
+    mainwindow.h \
+    pathchunkindex.h \
+    pathspatialindex.h \
+    playbackclock.h
+
+FORMS += \
+    mainwindow.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+RESOURCES += \
+    resources.qrc
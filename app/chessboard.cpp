@@ -0,0 +1,1101 @@
+#include "chessboard.h"
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <QScreen>
+#include <QtMath>
+#include <QFileInfo>
+#include <QBrush>
+#include <QPen>
+#include <QFont>
+#include <QDebug>
+#include <QPixmap>
+#include <QImage>
+#include <algorithm>
+#include <cmath>
+#include <QApplication>
+#include <QtConcurrent/QtConcurrentRun>
+
+
+Chessboard::Chessboard(QWidget *parent)
+    : QWidget(parent)
+    , m_isRunning(false)
+    , m_hasSolution(false)
+    , m_animationStep(0)
+    , m_lightColor(240, 217, 181)    // #f0d9b5（浅棕）
+    , m_darkColor(181, 136, 99)      // #b58863（深棕）
+    , m_selectedColor(0, 255, 255) // #00ffff（青色，选中起点）
+    , m_pathColor(129, 199, 132)     // #81c784（绿色，路径线）
+    , m_currentColor(255, 183, 77)   // #ffb74d（橙色，当前位置）
+{
+    // 初始化配置集中化
+    initWidget();
+    loadKnightImage();
+    initAnimationTimer();
+    connect(&m_tourWatcher, &QFutureWatcher<TourResult>::finished, this, &Chessboard::onTourCalculated);
+    reset(); // 初始化棋盘状态
+}
+
+// 析构时取消计算并等待所有工作线程退出（被取代的计算已在取代时取消，各阶段每 4096 格/节点检查一次取消标志）
+// 注意：此时主窗口可能已在析构，不能再发射信号
+Chessboard::~Chessboard()
+{
+    if (m_cancelFlag) {
+        m_cancelFlag->store(true, std::memory_order_relaxed);
+    }
+    m_tourPool.waitForDone();
+}
+
+// 初始化窗口基础配置
+void Chessboard::initWidget()
+{
+    setMinimumSize(MIN_WINDOW_SIZE, MIN_WINDOW_SIZE);
+    setWindowTitle("骑士巡游");
+    // 设置鼠标指针（棋盘模式时显示手型）
+    setCursor(Qt::PointingHandCursor);
+
+    // 2x2 棋盘格纹理：(x+y) 为偶数的格子为浅色，绘制时由画刷变换放大到格子大小
+    m_checkerTexture = QImage(2, 2, QImage::Format_RGB32);
+    m_checkerTexture.setPixel(0, 0, m_lightColor.rgb());
+    m_checkerTexture.setPixel(1, 1, m_lightColor.rgb());
+    m_checkerTexture.setPixel(1, 0, m_darkColor.rgb());
+    m_checkerTexture.setPixel(0, 1, m_darkColor.rgb());
+}
+
+// 初始化动画帧定时器：按显示刷新率采样播放时钟，播放速度与帧率无关
+void Chessboard::initAnimationTimer()
+{
+    const qreal refreshRate = screen() ? screen()->refreshRate() : 60.0;
+    m_animationTimer.setTimerType(Qt::PreciseTimer);
+    m_animationTimer.setInterval(qMax(1, qRound(1000.0 / refreshRate)));
+    m_playbackClock.setStepsPerSecond(PLAYBACK_SPEEDS[1]); // 默认中等速度
+    connect(&m_animationTimer, &QTimer::timeout, this, &Chessboard::onAnimationTimeout);
+}
+
+// 加载马的图片（优化资源加载逻辑）
+void Chessboard::loadKnightImage()
+{
+    // 支持多路径 fallback，提高可靠性
+    const QStringList imagePaths = {
+        u8":/images/knight.png",
+        u8":/images/f2LNqD2fxJ.jpg",
+        u8":/images/knight_default.png"
+    };
+
+    for (const QString& path : imagePaths) {
+        m_knightPixmap.load(path);
+        if (!m_knightPixmap.isNull()) {
+            qDebug() << "马的图片加载成功，路径：" << path << " 尺寸：" << m_knightPixmap.size();
+            return;
+        }
+    }
+
+    // 完全加载失败时，创建更美观的默认图形
+    qWarning() << "警告：所有马的图片路径加载失败！使用默认图形替代";
+    QImage defaultImage(64, 64, QImage::Format_ARGB32);
+    defaultImage.fill(Qt::transparent); // 透明背景
+    QPainter p(&defaultImage);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setBrush(QColor(72, 61, 139)); // 深紫色
+    p.setPen(Qt::white);
+    p.drawEllipse(4, 4, 56, 56);     // 圆形底座
+    p.setBrush(Qt::white);
+    p.drawText(defaultImage.rect(), Qt::AlignCenter, "马"); // 中文标识
+    m_knightPixmap = QPixmap::fromImage(defaultImage);
+}
+
+// 重置棋盘状态（优化状态清零逻辑）
+void Chessboard::reset()
+{
+    cancelCalculation();
+    m_animationTimer.stop();
+    m_isPaused = false;
+
+    // 高效重置数组（避免重复 memset）
+    clearStepMarks();
+
+    // 状态变量统一重置（先清空索引，再关闭它引用的路径文件）
+    m_path.clear();
+    m_fileIndex.clear();
+    m_tourFile.reset();
+    m_startPos = m_currentPos = QPoint(-1, -1);
+    m_isRunning = m_hasSolution = m_returnedToStart = false;
+    m_animationStep = 0;
+    resetPathCaches();
+
+    update();
+    emit statusChanged(tr("请选择起始位置"));
+    emit startBtnEnabled(false);
+}
+
+// 设置动画速度（优化参数校验和用户反馈）
+void Chessboard::setSpeed(int level)
+{
+    // 范围校验，避免无效值
+    level = qBound(0, level, 3);
+    switch (level) {
+    case 0: emit statusChanged(tr("动画速度：慢")); break;
+    case 1: emit statusChanged(tr("动画速度：中")); break;
+    case 2: emit statusChanged(tr("动画速度：快")); break;
+    case 3: emit statusChanged(tr("动画速度：极快")); break;
+    }
+    m_playbackClock.setStepsPerSecond(PLAYBACK_SPEEDS[level]);
+}
+
+void Chessboard::setStepsPerSecond(double stepsPerSecond)
+{
+    m_playbackClock.setStepsPerSecond(stepsPerSecond);
+}
+
+// 跳转只重设时钟锚点与当前步骤；累积层在绘制时按需回退重建或增量补画
+void Chessboard::seek(qint64 step)
+{
+    if (!m_isRunning || m_isCalculating || !m_hasSolution) {
+        return;
+    }
+    step = qBound<qint64>(1, step, pathLength());
+    m_playbackClock.seek(step);
+    advanceTo(step);
+}
+
+// 设置起始位置（优化参数校验和状态一致性）
+void Chessboard::setStartPosition(const QPoint& pos)
+{
+    // 严格坐标校验
+    if (!isValidPos(pos)) {
+        qWarning() << "无效的起始位置：" << pos;
+        return;
+    }
+    if (!isEditableSize()) {
+        emit statusChanged(tr("%1x%2 棋盘超出计算上限 %3x%3，只能演示路径文件")
+                               .arg(m_boardWidth).arg(m_boardHeight).arg(MAX_BOARD_SIZE));
+        return;
+    }
+
+    m_startPos = m_currentPos = pos;
+    stepAt(pos) = 1;
+    m_path.append(pos);
+    resetPathCaches();
+
+    update();
+    emit statusChanged(tr("起始位置：(%1, %2)").arg(pos.x()+1).arg(pos.y()+1));
+    emit startBtnEnabled(true);
+}
+
+// 开始骑士巡游（优化异步逻辑和用户体验）
+void Chessboard::startTour()
+{
+    if (!isValidPos(m_startPos) || m_isRunning) {
+        emit statusChanged(tr("无法开始：请先选择有效起始位置"));
+        return;
+    }
+
+    // 障碍布局不可能有解时立即提示（微秒级），不必等到搜索超时
+    const Infeasibility infeasibility = checkTourFeasibility(m_tourOptions, Square(m_startPos.x(), m_startPos.y()));
+    if (infeasibility != Infeasibility::None) {
+        emit statusChanged(tr("无解：%1").arg(describeInfeasibility(infeasibility)));
+        emit tourFinished(false);
+        return;
+    }
+
+    m_isRunning = true;
+    emit statusChanged(tr("正在计算路径..."));
+    emit startBtnEnabled(false);
+
+    // 异步计算（工作线程执行，GUI 线程不阻塞）
+    calculateTour();
+}
+
+// 路径计算（提交到工作线程，便于调试和维护）
+void Chessboard::calculateTour()
+{
+    // 每次计算使用独立的取消标志，被取消的旧计算不会影响新计算；被取代的计算一律取消
+    if (m_cancelFlag) {
+        m_cancelFlag->store(true, std::memory_order_relaxed);
+    }
+    m_cancelFlag = std::make_shared<std::atomic<bool>>(false);
+
+    const std::shared_ptr<std::atomic<bool>> cancelFlag = m_cancelFlag;
+    const std::shared_ptr<TourCache> tourCache = m_tourCache;
+    const Square start(m_startPos.x(), m_startPos.y());
+
+    m_isCalculating = true;
+    emit calculatingChanged(true);
+    // setFuture 会停止监视上一次计算，旧结果不会再触发 finished
+    m_tourWatcher.setFuture(QtConcurrent::run(&m_tourPool, [options = m_tourOptions, budget = m_searchBudget, start, cancelFlag, tourCache]() mutable {
+        budget.cancelFlag = cancelFlag.get(); // 标志由 shared_ptr 持有，工作线程结束前始终有效
+        // 同尺寸已有闭合回路时直接旋转到新起点，不再搜索
+        TourResult result;
+        if (tourCache->lookup(options, start, result)) {
+            return result;
+        }
+        // 无障碍的马闭合回路在受支持的尺寸上直接分治构造（线性时间，不会失败）
+        if (options.closed && options.leaper == LeaperType::Knight && options.obstacles.empty()
+            && StructuredTour::isSupported(options.width, options.height)) {
+            result = StructuredTour(options.width, options.height).solve(start, cancelFlag.get());
+            if (result.success) {
+                tourCache->store(options, result);
+            }
+            if (result.stopReason != StopReason::None) {
+                return result; // 成功或已取消
+            }
+        }
+        // 先做一次线性时间的无回溯构造（Roth 规则），走入死路时再回退到完整搜索
+        result = WarnsdorffTour(options, TieBreak::Roth).solve(start, cancelFlag.get());
+        if (result.success) {
+            tourCache->store(options, result);
+        }
+        if (result.stopReason != StopReason::DeadEnd) {
+            return result; // 成功、已取消或起点无效
+        }
+        // 多核并行：不同辅助排序的实例竞速，避免个别起点陷入长时间回溯
+        PortfolioSolver solver(options);
+        solver.setTourCache(tourCache.get());
+        return solver.solve(start, budget);
+    }));
+}
+
+// 取消路径计算（不等待工作线程，保证界面不卡顿）
+void Chessboard::cancelCalculation()
+{
+    if (!m_isCalculating) {
+        return;
+    }
+
+    // 已取消的计算完成后 onTourCalculated 会因 m_isCalculating=false 丢弃其结果
+    m_cancelFlag->store(true, std::memory_order_relaxed);
+    m_isCalculating = false;
+    m_isRunning = false;
+    emit calculatingChanged(false);
+    emit tourFinished(false);
+}
+
+// 工作线程计算完成（回到 GUI 线程处理结果）
+void Chessboard::onTourCalculated()
+{
+    if (!m_isCalculating) {
+        return;
+    }
+    m_isCalculating = false;
+    const TourResult result = m_tourWatcher.result();
+
+    // 将求解结果转换为绘制所需的数据（避免残留数据影响）
+    clearStepMarks();
+    m_path.clear();
+    if (result.success) {
+        m_path.reserve(static_cast<int>(result.path.size()));
+        for (const Square& sq : result.path) {
+            m_path.append(QPoint(sq.x, sq.y));
+            stepAt(m_path.last()) = m_path.size();
+        }
+    } else {
+        stepAt(m_startPos) = 1;
+        m_path.append(m_startPos);
+    }
+    resetPathCaches();
+
+    m_hasSolution = result.success;
+    m_tourClosed = m_tourOptions.closed;
+    if (result.stopReason == StopReason::Deadline) {
+        qWarning() << "回溯超时，终止计算（已耗时" << result.elapsedMs << "ms）";
+    }
+    emit searchStatsChanged(formatSearchStats(result));
+
+    emit calculatingChanged(false);
+    if (m_hasSolution) {
+        startPlayback();
+    } else {
+        emit statusChanged(tr("未找到有效路径（计算耗时%1ms），请重新选择起点").arg(result.elapsedMs));
+        m_isRunning = false;
+        emit tourFinished(false);
+        emit startBtnEnabled(true);
+    }
+}
+
+void Chessboard::startPlayback()
+{
+    emit statusChanged(tr("开始演示遍历过程（共%1步）").arg(pathLength()));
+    m_animationStep = 1;
+    m_currentPos = pathAt(0);
+    m_returnedToStart = false;
+    m_playbackClock.start(1);
+    m_animationTimer.start();
+    emit playbackProgress(m_animationStep, pathLength());
+}
+
+void Chessboard::setBoardDimensions(int width, int height)
+{
+    m_boardWidth = width;
+    m_boardHeight = height;
+    m_tourOptions.width = width;
+    m_tourOptions.height = height;
+    m_tourOptions.obstacles.clear(); // 障碍按 x * height + y 存储，尺寸改变后失效
+    clearStepMarks();
+    m_fitView = true;
+    update();
+}
+
+bool Chessboard::setBoardSize(int width, int height)
+{
+    if (width < 1 || height < 1 || width > MAX_BOARD_SIZE || height > MAX_BOARD_SIZE
+        || (m_isRunning && !m_isCalculating)) {
+        return false;
+    }
+
+    reset();
+    setBoardDimensions(width, height);
+    resetPathCaches();
+    if (m_tourOptions.closed && m_tourOptions.leaper == LeaperType::Knight && !closedKnightTourExists(width, height)) {
+        emit statusChanged(tr("%1x%2 棋盘上不存在马的闭合回路，请选择其他尺寸").arg(width).arg(height));
+    } else {
+        emit statusChanged(tr("棋盘尺寸：%1x%2，请选择起始位置").arg(width).arg(height));
+    }
+    return true;
+}
+
+void Chessboard::clearStepMarks()
+{
+    if (isEditableSize()) {
+        m_board.fill(0, m_boardWidth * m_boardHeight);
+    } else {
+        m_board.clear();
+    }
+}
+
+// 保存：逐格流式写入（格子已在绘制数据或载入的文件中，无需再复制一份路径）
+bool Chessboard::saveTour(const QString& fileName)
+{
+    if (!m_hasSolution || pathLength() == 0) {
+        emit statusChanged(tr("没有可保存的路径"));
+        return false;
+    }
+
+    TourFileWriter writer;
+    bool ok = writer.open(fileName.toStdString(), m_boardWidth, m_boardHeight, m_tourOptions.leaper);
+    if (ok) {
+        forEachStep(0, pathLength() - 1, [&](qint64, const QPoint& pos) {
+            ok = ok && writer.append(Square(pos.x(), pos.y()));
+        });
+    }
+    ok = ok && writer.finish();
+    if (ok) {
+        emit statusChanged(tr("路径已保存：%1").arg(QFileInfo(fileName).fileName()));
+    } else {
+        emit statusChanged(tr("保存失败：%1").arg(QString::fromStdString(writer.errorString())));
+    }
+    return ok;
+}
+
+// 载入：映射文件后只读文件头（O(1)），文件在演示期间保持打开，播放与绘制按需解码
+bool Chessboard::loadTour(const QString& fileName)
+{
+    if (m_isRunning && !m_isCalculating) {
+        emit statusChanged(tr("遍历中，无法载入路径"));
+        return false;
+    }
+
+    std::unique_ptr<TourFile> file = std::make_unique<TourFile>();
+    if (!file->open(fileName.toStdString())) {
+        emit statusChanged(tr("打开失败：%1").arg(QString::fromStdString(file->errorString())));
+        return false;
+    }
+
+    reset();
+    setBoardDimensions(file->width(), file->height());
+    m_tourOptions.leaper = file->leaper();
+    m_tourFile = std::move(file);
+    m_fileIndex.reset(m_tourFile.get());
+
+    m_startPos = pathAt(0);
+    if (!isValidPos(m_startPos)) {
+        abortCorruptFile(0);
+        return false;
+    }
+    m_hasSolution = pathLength() == freeSquareCount();
+    m_tourClosed = m_tourFile->isClosed();
+    m_isRunning = true;
+    resetPathCaches();
+    emit startBtnEnabled(false);
+    startPlayback();
+    return true;
+}
+
+void Chessboard::abortCorruptFile(qint64 badStep)
+{
+    m_animationTimer.stop();
+    reset();
+    emit statusChanged(tr("路径文件已损坏：第%1步无效").arg(badStep + 1));
+    emit tourFinished(false);
+}
+
+// 动画帧定时器处理：步骤由播放时钟决定，定时器只负责采样
+void Chessboard::onAnimationTimeout()
+{
+    if (m_isPaused) return; // 暂停时不推进
+
+    // 最后一步停留一个步长后结束（与逐步推进时一致）
+    const double position = m_playbackClock.position();
+    if (position >= pathLength() + 1) {
+        advanceTo(pathLength());
+        if (m_isRunning) {
+            finishAnimation(); // 路径文件损坏时 advanceTo 已停止演示
+        }
+        return;
+    }
+    advanceTo(static_cast<qint64>(position));
+}
+
+void Chessboard::advanceTo(qint64 step)
+{
+    step = qBound<qint64>(1, step, pathLength());
+    const qint64 previousStep = m_animationStep;
+    if (step == previousStep) {
+        return;
+    }
+    // 路径文件：首次到达的步骤先顺序解码并校验，之后的绘制只读取已校验的部分
+    qint64 badStep = 0;
+    if (isFilePlayback() && !m_fileIndex.extendTo(step - 1, &badStep)) {
+        abortCorruptFile(badStep);
+        return;
+    }
+    m_animationStep = step;
+    m_currentPos = pathAt(step - 1);
+
+    // 脏区域：经过的所有格子（新增/撤销的线段都落在相邻两格之间），其余部分由累积层保持；
+    // 一帧跨越的步数太多时直接整体重绘
+    if (previousStep >= 1 && qAbs(step - previousStep) <= MAX_DIRTY_STEPS) {
+        QRectF dirty = cellRect(m_currentPos);
+        forEachStep(qMin(previousStep, step) - 1, qMax(previousStep, step) - 1, [&](qint64, const QPoint& pos) {
+            dirty |= cellRect(pos);
+        });
+        const int margin = qCeil(MIN_MARKER_SIZE); // 远景下的最小高亮方块与线宽
+        update(dirty.toAlignedRect().adjusted(-margin, -margin, margin, margin));
+    } else {
+        update();
+    }
+    // 实时更新进度
+    emit statusChanged(tr("遍历中：第%1步").arg(m_animationStep));
+    emit playbackProgress(m_animationStep, pathLength());
+}
+
+// 动画结束处理（统一收尾逻辑）
+void Chessboard::finishAnimation()
+{
+    m_animationTimer.stop();
+    m_isRunning = false;
+    m_isPaused = false; // 重置暂停状态
+
+    if (m_hasSolution && !m_tourClosed) {
+        emit statusChanged(tr("遍历完成！（共%1步）").arg(pathLength()));
+        emit tourFinished(true);
+    } else if (m_hasSolution) {
+        // 标记返回起点的步骤（视觉优化；起点数字改变，累积层重建一次）
+        m_returnedToStart = true;
+        if (!isFilePlayback()) {
+            stepAt(m_startPos) = m_path.size() + 1;
+        }
+        invalidatePathLayers();
+        m_currentPos = m_startPos;
+        update();
+        emit statusChanged(tr("遍历完成！已返回起点（共%1步）").arg(pathLength() + 1));
+        emit tourFinished(true);
+    } else {
+        emit statusChanged(tr("遍历中断：未找到完整路径"));
+        emit tourFinished(false);
+    }
+}
+
+// 检查坐标是否有效（工具函数，减少重复代码）
+bool Chessboard::isValidPos(const QPoint& pos) const
+{
+    return pos.x() >= 0 && pos.x() < m_boardWidth &&
+           pos.y() >= 0 && pos.y() < m_boardHeight;
+}
+
+QString Chessboard::describeInfeasibility(Infeasibility reason) const
+{
+    switch (reason) {
+    case Infeasibility::None:           return QString();
+    case Infeasibility::InvalidStart:   return tr("起点无效或被阻挡");
+    case Infeasibility::NoClosedTour:   return tr("%1x%2 棋盘上不存在马的闭合回路").arg(m_boardWidth).arg(m_boardHeight);
+    case Infeasibility::ColorImbalance: return tr("深浅格子数量不满足交替要求");
+    case Infeasibility::LowDegree:      return tr("有格子的可用邻居太少，无法经过");
+    case Infeasibility::Disconnected:   return tr("可用格子不连通");
+    }
+    return QString();
+}
+
+// 统计摘要（搜索统计未编译时只显示节点数与耗时）
+QString Chessboard::formatSearchStats(const TourResult& result) const
+{
+    if (result.fromCache) {
+        return tr("来自回路缓存，未搜索");
+    }
+
+    QString summary = tr("节点：%1，耗时：%2ms").arg(result.nodes).arg(result.elapsedMs);
+    const SearchStats& stats = result.stats;
+    if (!stats.enabled) {
+        return summary;
+    }
+
+    // 平均分支因子：所有展开的栈帧的候选数均值
+    long long frames = 0;
+    long long moves = 0;
+    for (const auto& histogram : stats.branching) {
+        for (int k = 0; k <= MOVE_COUNT; k++) {
+            frames += histogram[k];
+            moves += histogram[k] * k;
+        }
+    }
+    summary += tr("，回溯：%1，最大深度：%2，首次回溯深度：%3，平均分支：%4，走法生成/排序：%5/%6ms")
+                   .arg(stats.backtracks)
+                   .arg(stats.maxDepth)
+                   .arg(stats.firstBacktrackDepth)
+                   .arg(frames > 0 ? static_cast<double>(moves) / frames : 0.0, 0, 'f', 2)
+                   .arg(stats.moveGenNs / 1e6, 0, 'f', 1)
+                   .arg(stats.orderingNs / 1e6, 0, 'f', 1);
+    return summary;
+}
+
+// 绘制棋盘：棋盘格用纹理画刷填充，路径与数字来自可见区域的累积层（远景改用密度纹理），每帧只画当前位置与马
+void Chessboard::paintEvent(QPaintEvent *event)
+{
+    ensureView();
+    if (m_zoom <= 0) {
+        return;
+    }
+
+    QPainter painter(this);
+    painter.setClipRect(event->rect()); // 只重绘脏区域（动画每步只有前后两个格子）
+
+    // 分层绘制（棋盘格 -> 起点高亮 -> 路径 -> 数字 -> 当前位置 -> 马）
+    drawBoardGrid(painter);
+    drawObstacles(painter);
+    // 未运行时高亮起点
+    if (!m_isRunning && isValidPos(m_startPos)) {
+        painter.fillRect(cellRect(m_startPos), m_selectedColor);
+    }
+    if (isDensityMode()) {
+        drawDensity(painter);
+    } else {
+        syncPathLayers();
+        painter.drawPixmap(0, 0, m_pathLayer);
+        painter.drawPixmap(0, 0, m_labelLayer);
+    }
+    drawCurrentPosition(painter);
+    drawKnightIcon(painter);
+}
+
+// 适应窗口时每次重新计算；缩放、中心、组件大小或设备像素比变化时，依赖视图的缓存失效
+void Chessboard::ensureView()
+{
+    const qreal fit = fitZoom();
+    if (m_fitView || m_zoom < fit) {
+        m_fitView = true;
+        m_zoom = fit;
+        m_viewCenter = QPointF(m_boardWidth / 2.0, m_boardHeight / 2.0);
+    }
+    if (m_zoom <= 0) {
+        return;
+    }
+
+    const qreal ratio = devicePixelRatioF();
+    if (m_zoom == m_layerZoom && m_viewCenter == m_layerCenter && size() == m_layerSize && ratio == m_layerRatio) {
+        return;
+    }
+    if (m_zoom != m_layerZoom || ratio != m_layerRatio) {
+        rebuildKnightSprite();
+
+        // 字号按半磅取整，缩放时只有字号真正变化才重新排版数字
+        const qreal pointSize = qMax(1.0, qRound(m_zoom * 0.5) / 2.0); // 自适应字体大小（格子的 1/4）
+        if (pointSize != m_labelFont.pointSizeF() || !m_labelFont.bold()) {
+            m_labelFont = QFont();
+            m_labelFont.setPointSizeF(pointSize);
+            m_labelFont.setBold(true);
+            m_labelCache.clear();
+        }
+    }
+    m_layerZoom = m_zoom;
+    m_layerCenter = m_viewCenter;
+    m_layerSize = size();
+    m_layerRatio = ratio;
+    invalidatePathLayers();
+}
+
+qreal Chessboard::fitZoom() const
+{
+    const qreal zoom = qMin(static_cast<qreal>(width()) / m_boardWidth, static_cast<qreal>(height()) / m_boardHeight);
+    return zoom >= 1 ? std::floor(zoom) : zoom; // 格子不小于一个像素时取整，格线清晰
+}
+
+void Chessboard::zoomAt(const QPointF& anchor, qreal factor)
+{
+    ensureView();
+    if (m_zoom <= 0) {
+        return;
+    }
+
+    // 锚点下的棋盘坐标在缩放前后保持不动
+    const QPointF offset = anchor - QPointF(width() / 2.0, height() / 2.0);
+    const QPointF board = offset / m_zoom + m_viewCenter;
+    const qreal fit = fitZoom();
+    const qreal zoom = qBound(fit, m_zoom * factor, qMax(fit, MAX_CELL_SIZE));
+
+    m_fitView = zoom <= fit;
+    m_zoom = zoom;
+    m_viewCenter = board - offset / zoom;
+    clampView();
+    update();
+}
+
+void Chessboard::panBy(const QPointF& delta)
+{
+    if (m_fitView || m_zoom <= 0) {
+        return; // 整盘可见时无需平移
+    }
+    m_viewCenter -= delta / m_zoom;
+    clampView();
+    update();
+}
+
+void Chessboard::clampView()
+{
+    if (m_fitView) {
+        m_viewCenter = QPointF(m_boardWidth / 2.0, m_boardHeight / 2.0);
+        return;
+    }
+    m_viewCenter.setX(qBound(0.0, m_viewCenter.x(), static_cast<qreal>(m_boardWidth)));
+    m_viewCenter.setY(qBound(0.0, m_viewCenter.y(), static_cast<qreal>(m_boardHeight)));
+}
+
+QPointF Chessboard::toWidget(const QPointF& board) const
+{
+    return (board - m_viewCenter) * m_zoom + QPointF(width() / 2.0, height() / 2.0);
+}
+
+QPoint Chessboard::cellAt(const QPointF& widgetPos) const
+{
+    const QPointF board = (widgetPos - QPointF(width() / 2.0, height() / 2.0)) / m_zoom + m_viewCenter;
+    return QPoint(qFloor(board.x()), qFloor(board.y()));
+}
+
+QRectF Chessboard::cellRect(const QPoint& pos) const
+{
+    return QRectF(toWidget(QPointF(pos)), QSizeF(m_zoom, m_zoom));
+}
+
+QRect Chessboard::visibleCells() const
+{
+    return QRect(cellAt(QPointF(0, 0)), cellAt(QPointF(width(), height())))
+        .intersected(QRect(0, 0, m_boardWidth, m_boardHeight));
+}
+
+// 路径改变：索引与密度纹理按新路径重建（计算得到的路径 O(n)，每条路径一次；路径文件的分段索引随播放建立）
+void Chessboard::resetPathCaches()
+{
+    if (isFilePlayback()) {
+        m_pathIndex.clear();
+    } else {
+        m_pathIndex.build(m_path, m_boardWidth, m_boardHeight);
+    }
+    m_density.reset(m_boardWidth, m_boardHeight, m_pathColor);
+    m_densityStep = 0;
+    invalidatePathLayers();
+}
+
+// 创建透明图层（物理像素分配，逻辑坐标绘制）
+QPixmap Chessboard::createLayer() const
+{
+    const qreal ratio = devicePixelRatioF();
+    QPixmap layer(size() * ratio);
+    layer.setDevicePixelRatio(ratio);
+    layer.fill(Qt::transparent);
+    return layer;
+}
+
+// 马的图标按格子大小缩放一次（保持比例），绘制时不再缩放
+void Chessboard::rebuildKnightSprite()
+{
+    if (m_knightPixmap.isNull() || m_zoom < MIN_SPRITE_CELL_SIZE) {
+        m_knightSprite = QPixmap();
+        return;
+    }
+    const qreal ratio = devicePixelRatioF();
+    const int iconSize = m_zoom * 0.8;
+    m_knightSprite = m_knightPixmap.scaled(QSize(iconSize, iconSize) * ratio,
+                                           Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    m_knightSprite.setDevicePixelRatio(ratio);
+}
+
+void Chessboard::invalidatePathLayers()
+{
+    m_layerStep = -1;
+    m_layerClosed = false;
+}
+
+// 累积层：第 s 步新增线段 path[s-2]->path[s-1] 与数字 s；不可见的部分不画，视图变化时重建
+void Chessboard::syncPathLayers()
+{
+    const qint64 targetStep = qMin(m_animationStep, pathLength());
+    const bool closeTour = m_hasSolution && m_tourClosed && pathLength() >= 2 && m_animationStep >= pathLength();
+    if (m_layerStep >= 0 && m_layerStep == targetStep && m_layerClosed == closeTour) {
+        return;
+    }
+
+    // 一次前进的步数多于可见格子数（跳转、极快播放）时，重建比逐步补画更省
+    const QRect cells = visibleCells();
+    const long long visibleCount = static_cast<long long>(cells.width()) * cells.height();
+    if (m_layerStep < 0 || m_layerStep > targetStep || targetStep - m_layerStep > visibleCount) {
+        m_pathLayer = createLayer();
+        m_labelLayer = createLayer();
+        m_layerStep = 0;
+        m_layerClosed = false;
+    }
+    // 线段可见：其包围盒（两端格子）与可见格子相交
+    auto segmentVisible = [&cells](const QPoint& from, const QPoint& to) {
+        return QRect(QPoint(qMin(from.x(), to.x()), qMin(from.y(), to.y())),
+                     QPoint(qMax(from.x(), to.x()), qMax(from.y(), to.y()))).intersects(cells);
+    };
+
+    QPainter pathPainter(&m_pathLayer);
+    pathPainter.setRenderHint(QPainter::Antialiasing);
+    pathPainter.setPen(QPen(m_pathColor, 2, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+
+    // 格子太小时数字无法辨认，不排版也不绘制
+    const bool showLabels = m_zoom >= MIN_LABEL_CELL_SIZE;
+    QPainter labelPainter(&m_labelLayer);
+    labelPainter.setRenderHint(QPainter::Antialiasing);
+    labelPainter.setFont(m_labelFont);
+    labelPainter.setPen(Qt::white);
+
+    if (m_layerStep == 0 && isFilePlayback()) {
+        // 路径文件重建：只解码包围盒与可见区域相交的段
+        QVector<QLineF> lines;
+        m_fileIndex.query(cells, targetStep - 1, [&](qint64 index, const QPoint& from, const QPoint& pos) {
+            if (index > 0 && segmentVisible(from, pos)) {
+                lines.append(pathLine(from, pos));
+            }
+            const qint64 label = stepMark(index + 1);
+            if (showLabels && label <= m_animationStep && cells.contains(pos)) {
+                drawStepNumber(labelPainter, pos, label);
+            }
+        });
+        pathPainter.drawLines(lines);
+    } else if (m_layerStep == 0) {
+        // 重建：空间索引只返回与可见区域相交的线段，数字只遍历可见格子
+        QVector<QLineF> lines;
+        m_pathIndex.query(m_path, cells, static_cast<int>(targetStep) - 1, [&](int segment) {
+            lines.append(pathLine(m_path[segment - 1], m_path[segment]));
+        });
+        pathPainter.drawLines(lines);
+
+        if (showLabels && !cells.isEmpty()) {
+            for (int y = cells.top(); y <= cells.bottom(); y++) {
+                for (int x = cells.left(); x <= cells.right(); x++) {
+                    const int label = stepAt(QPoint(x, y));
+                    if (label > 0 && label <= m_animationStep) {
+                        drawStepNumber(labelPainter, QPoint(x, y), label);
+                    }
+                }
+            }
+        }
+    } else {
+        // 增量：顺序访问新增的步骤（路径文件用游标解码），从上一次同步到的格子接上线段
+        QPoint previous = m_layerStep >= 1 ? pathAt(m_layerStep - 1) : QPoint();
+        forEachStep(m_layerStep, targetStep - 1, [&](qint64 index, const QPoint& pos) {
+            if (index >= 1 && segmentVisible(previous, pos)) {
+                pathPainter.drawLine(pathLine(previous, pos));
+            }
+            previous = pos;
+            // 与原逻辑一致：返回起点的标记超出动画步骤，不显示
+            const qint64 label = stepMark(index + 1);
+            if (showLabels && label <= m_animationStep && cells.contains(pos)) {
+                drawStepNumber(labelPainter, pos, label);
+            }
+        });
+    }
+    m_layerStep = targetStep;
+
+    if (closeTour && !m_layerClosed) {
+        const QPoint last = pathAt(pathLength() - 1);
+        const QPoint first = pathAt(0);
+        if (segmentVisible(last, first)) {
+            pathPainter.drawLine(pathLine(last, first));
+        }
+        m_layerClosed = true;
+    }
+}
+
+// 密度纹理只在远景绘制前同步：前进标记新格子，后退（重新演示）撤销多出的格子
+void Chessboard::syncDensity()
+{
+    const qint64 targetStep = qMin(m_animationStep, pathLength());
+    if (m_densityStep < targetStep) {
+        forEachStep(m_densityStep, targetStep - 1, [this](qint64, const QPoint& pos) { m_density.add(pos); });
+    } else if (m_densityStep > targetStep) {
+        forEachStep(targetStep, m_densityStep - 1, [this](qint64, const QPoint& pos) { m_density.remove(pos); });
+    }
+    m_densityStep = targetStep;
+}
+
+QLineF Chessboard::pathLine(const QPoint& from, const QPoint& to) const
+{
+    const QPointF half(0.5, 0.5);
+    return QLineF(toWidget(QPointF(from) + half), toWidget(QPointF(to) + half));
+}
+
+// 绘制棋盘格子：不逐格填充，纹理画刷经变换后一次覆盖所有可见格子
+void Chessboard::drawBoardGrid(QPainter& painter)
+{
+    const QPointF origin = toWidget(QPointF(0, 0));
+    const QRectF board = QRectF(origin, QSizeF(m_boardWidth * m_zoom, m_boardHeight * m_zoom)).intersected(rect());
+    if (isDensityMode()) {
+        // 远景格子只有几个像素，棋盘格只会产生摩尔纹，改用两种颜色的平均色
+        painter.fillRect(board, QColor((m_lightColor.red() + m_darkColor.red()) / 2,
+                                       (m_lightColor.green() + m_darkColor.green()) / 2,
+                                       (m_lightColor.blue() + m_darkColor.blue()) / 2));
+        return;
+    }
+
+    QBrush checker(m_checkerTexture);
+    checker.setTransform(QTransform::fromTranslate(origin.x(), origin.y()).scale(m_zoom, m_zoom));
+    painter.fillRect(board, checker);
+}
+
+// 障碍格子由用户逐个点击设置，数量远少于可见格子，按位集逐个取出
+void Chessboard::drawObstacles(QPainter& painter)
+{
+    const ObstacleMask& obstacles = m_tourOptions.obstacles;
+    if (obstacles.empty()) {
+        return;
+    }
+    const QRect cells = visibleCells();
+    for (size_t word = 0; word < obstacles.words.size(); word++) {
+        for (Bitboard bits = obstacles.words[word]; bits != 0; bits &= bits - 1) {
+            const int index = static_cast<int>(word * 64) + lowestBitIndex(bits);
+            const QPoint pos(index / m_boardHeight, index % m_boardHeight);
+            if (cells.contains(pos)) {
+                painter.fillRect(cellRect(pos), m_obstacleColor);
+            }
+        }
+    }
+}
+
+// 远景：纹素约等于一个像素的一层纹理，只取可见部分平滑缩放
+void Chessboard::drawDensity(QPainter& painter)
+{
+    syncDensity();
+    const QRect cells = visibleCells();
+    if (cells.isEmpty() || m_density.levelCount() == 0) {
+        return;
+    }
+
+    const int level = m_density.levelFor(m_zoom);
+    const QRect texels(QPoint(cells.left() >> level, cells.top() >> level),
+                       QPoint(cells.right() >> level, cells.bottom() >> level));
+    const qreal texelSize = m_zoom * (1 << level);
+    const QRectF target(toWidget(QPointF(texels.topLeft() * (1 << level))),
+                        QSizeF(texels.width() * texelSize, texels.height() * texelSize));
+
+    painter.save();
+    // 边缘纹素可能伸出棋盘，裁剪到棋盘范围
+    painter.setClipRect(QRectF(toWidget(QPointF(0, 0)), QSizeF(m_boardWidth * m_zoom, m_boardHeight * m_zoom)),
+                        Qt::IntersectClip);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.drawImage(target, m_density.image(level), texels);
+    painter.restore();
+}
+
+// 步骤数字只排版一次：QStaticText 缓存字形布局，之后每次绘制只贴字形；
+// 长路径文件在不同区域间跳转时缓存可能不断增长，超过上限时整体清空
+const QStaticText& Chessboard::stepLabel(qint64 step)
+{
+    if (m_labelCache.size() >= MAX_CACHED_LABELS && !m_labelCache.contains(step)) {
+        m_labelCache.clear();
+    }
+    QStaticText& label = m_labelCache[step];
+    if (label.text().isEmpty()) {
+        label.setText(QString::number(step));
+        label.setTextFormat(Qt::PlainText);
+        label.setPerformanceHint(QStaticText::AggressiveCaching);
+        label.prepare(QTransform(), m_labelFont);
+    }
+    return label;
+}
+
+// 绘制一个步骤数字（半透明黑色背景圆 + 居中数字）
+void Chessboard::drawStepNumber(QPainter& painter, const QPoint& pos, qint64 step)
+{
+    const qreal dotSize = m_zoom / 3;
+    const QRectF dotRect(cellRect(pos).topLeft() + QPointF(5, 5), QSizeF(dotSize, dotSize));
+    painter.setBrush(QColor(0, 0, 0, 180));
+    painter.drawEllipse(dotRect);
+
+    const QStaticText& label = stepLabel(step);
+    const QSizeF labelSize = label.size();
+    painter.drawStaticText(QPointF(dotRect.x() + (dotSize - labelSize.width()) / 2,
+                                   dotRect.y() + (dotSize - labelSize.height()) / 2),
+                           label);
+}
+
+// 绘制当前位置（优化高亮效果）
+void Chessboard::drawCurrentPosition(QPainter& painter)
+{
+    if (!isValidPos(m_currentPos)) {
+        return;
+    }
+
+    // 远景下格子可能不足一个像素，高亮至少画成 MIN_MARKER_SIZE 的方块
+    QRectF marker = cellRect(m_currentPos);
+    if (marker.width() < MIN_MARKER_SIZE) {
+        const QPointF center = marker.center();
+        marker.setSize(QSizeF(MIN_MARKER_SIZE, MIN_MARKER_SIZE));
+        marker.moveCenter(center);
+    }
+
+    // 半透明橙色覆盖（不影响底层数字）
+    QColor highlightColor = m_currentColor;
+    highlightColor.setAlpha(127);
+    painter.fillRect(marker, highlightColor);
+}
+
+// 绘制马的图标（预先缩放好的图标居中贴图）
+void Chessboard::drawKnightIcon(QPainter& painter)
+{
+    if (!isValidPos(m_currentPos) || m_knightSprite.isNull()) {
+        return;
+    }
+
+    const QSizeF iconSize = m_knightSprite.deviceIndependentSize();
+    const QRectF cell = cellRect(m_currentPos);
+    painter.drawPixmap(QPointF(cell.x() + (cell.width() - iconSize.width()) / 2,
+                               cell.y() + (cell.height() - iconSize.height()) / 2),
+                       m_knightSprite);
+}
+
+// 鼠标点击处理（优化坐标计算和用户体验）
+void Chessboard::mousePressEvent(QMouseEvent *event)
+{
+    // 右键或中键拖动平移视图
+    if (event->button() == Qt::RightButton || event->button() == Qt::MiddleButton) {
+        m_isPanning = true;
+        m_panAnchor = event->position();
+        setCursor(Qt::ClosedHandCursor);
+        return;
+    }
+    if (event->button() != Qt::LeftButton) {
+        return;
+    }
+
+    // 计算期间允许重新选择起点（reset 会取消当前计算）；仅动画演示时禁止
+    if (m_isRunning && !m_isCalculating) {
+        emit statusChanged(tr("遍历中，无法选择起点"));
+        return;
+    }
+
+    // 计算格子坐标（与绘制共用同一视图变换）
+    ensureView();
+    const QPoint cell = m_zoom > 0 ? cellAt(event->position()) : QPoint(-1, -1);
+
+    if (!isValidPos(cell)) {
+        emit statusChanged(tr("点击位置无效，请点击棋盘内格子"));
+    } else if (event->modifiers() & Qt::ControlModifier) {
+        toggleObstacle(cell);
+    } else if (isBlocked(cell)) {
+        emit statusChanged(tr("该格子是障碍，Ctrl+点击可移除"));
+    } else {
+        reset(); // 重置之前的选择
+        setStartPosition(cell);
+    }
+}
+
+// 切换障碍：先重置（取消计算、清除路径），再恢复未被阻挡的起点
+void Chessboard::toggleObstacle(const QPoint& pos)
+{
+    if (!isValidPos(pos) || (m_isRunning && !m_isCalculating) || !isEditableSize()) {
+        return;
+    }
+
+    const QPoint start = m_startPos;
+    reset();
+    m_tourOptions.obstacles.toggle(pos.x() * m_boardHeight + pos.y());
+    if (isValidPos(start) && !isBlocked(start)) {
+        setStartPosition(start);
+    }
+    update();
+    emit statusChanged(tr("%1障碍：(%2, %3)，共%4个障碍格子")
+                           .arg(isBlocked(pos) ? tr("设置") : tr("移除"))
+                           .arg(pos.x() + 1).arg(pos.y() + 1)
+                           .arg(m_tourOptions.obstacles.count()));
+}
+
+void Chessboard::setLeaper(LeaperType leaper)
+{
+    if (leaper == m_tourOptions.leaper || (m_isRunning && !m_isCalculating)) {
+        return;
+    }
+
+    const QPoint start = m_startPos;
+    reset();
+    m_tourOptions.leaper = leaper;
+    if (isValidPos(start)) {
+        setStartPosition(start);
+    }
+    update();
+}
+
+void Chessboard::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!m_isPanning) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+    const QPointF delta = event->position() - m_panAnchor;
+    m_panAnchor = event->position();
+    panBy(delta);
+}
+
+void Chessboard::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (m_isPanning && (event->button() == Qt::RightButton || event->button() == Qt::MiddleButton)) {
+        m_isPanning = false;
+        setCursor(Qt::PointingHandCursor);
+    }
+}
+
+// 滚轮缩放（每格 ZOOM_STEP 倍，触控板的小步长按比例缩放）
+void Chessboard::wheelEvent(QWheelEvent *event)
+{
+    const int delta = event->angleDelta().y();
+    if (delta == 0) {
+        event->ignore();
+        return;
+    }
+    zoomAt(event->position(), std::pow(ZOOM_STEP, delta / 120.0));
+    event->accept();
+}
+
+void Chessboard::setPaused(bool paused)
+{
+    if (!m_isRunning || m_isCalculating) return; // 未运行或仍在计算时忽略
+
+    m_isPaused = paused;
+    if (paused) {
+        m_animationTimer.stop();
+        m_playbackClock.pause();
+        emit statusChanged(tr("演示已暂停"));
+    } else {
+        m_playbackClock.resume();
+        m_animationTimer.start();
+        emit statusChanged(tr("演示继续"));
+    }
+    emit pausedChanged(paused); // 同步 UI
+}
+
+// 窗口大小变化时自适应（优化响应式布局）
+void Chessboard::resizeEvent(QResizeEvent *event)
+{
+    Q_UNUSED(event);
+    update(); // 视图在绘制时按新尺寸更新（适应窗口时重新计算缩放）
+}
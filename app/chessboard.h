@@ -0,0 +1,597 @@
+#ifndef CHESSBOARD_H
+#define CHESSBOARD_H
+
+#include <QWidget>
+#include <QPoint>
+#include <QVector>
+#include <QTimer>
+#include <QColor>
+#include <QPainter>
+#include <QPixmap>
+#include <QRect>
+#include <QRectF>
+#include <QLineF>
+#include <QImage>
+#include <QFont>
+#include <QStaticText>
+#include <QString>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+
+#include "densitypyramid.h"
+#include "pathchunkindex.h"
+#include "pathspatialindex.h"
+#include "playbackclock.h"
+#include "portfoliosolver.h"
+#include "structuredtour.h"
+#include "tourfeasibility.h"
+#include "tourfile.h"
+#include "warnsdorfftour.h"
+
+// 常量集中定义（与cpp文件保持一致，便于维护）
+constexpr int BOARD_SIZE = DEFAULT_BOARD_SIZE; // 默认棋盘大小（8x8）
+constexpr int MAX_BOARD_SIZE = 1000;           // 界面可设置（可选起点、计算路径）的最大边长；载入的路径文件不受限制
+constexpr int MIN_WINDOW_SIZE = 400;           // 窗口最小尺寸
+constexpr int MIN_LABEL_CELL_SIZE = 18;        // 格子小于该尺寸（像素）时不显示步骤数字（无法辨认）
+constexpr qreal LOD_CELL_SIZE = 6;             // 格子小于该尺寸（像素）时路径改用密度纹理绘制
+constexpr qreal MIN_SPRITE_CELL_SIZE = 8;      // 格子小于该尺寸（像素）时不绘制马的图标
+constexpr qreal MIN_MARKER_SIZE = 6;           // 当前位置高亮的最小尺寸（像素，远景下保持可见）
+constexpr qreal MAX_CELL_SIZE = 240;           // 放大上限（像素/格）
+constexpr qreal ZOOM_STEP = 1.25;              // 滚轮每格的缩放倍数
+constexpr int MAX_DIRTY_STEPS = 64;            // 一帧内前进/后退超过该步数时整体重绘，不再逐格合并脏区域
+constexpr int MAX_CACHED_LABELS = 65536;       // 步骤数字排版缓存的上限（超出时清空，长路径文件不会无限增长）
+constexpr double PLAYBACK_SPEEDS[] = {1, 2, 5, 2000}; // 各速度等级的播放速度（步/秒）
+
+/**
+ * @brief 骑士巡游棋盘组件
+ * 无障碍的闭合马巡游在受支持的尺寸上由 StructuredTour 直接构造，其余情况先尝试 WarnsdorffTour 单遍构造，失败时调用 PortfolioSolver 并行求解骑士巡游（哈密顿回路），负责可视化演示
+ */
+class Chessboard : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit Chessboard(QWidget *parent = nullptr);
+    ~Chessboard() override;
+
+    /**
+     * @brief 设置起始位置
+     * @param pos 棋盘坐标（0-based，x:0~宽-1，y:0~高-1）
+     */
+    void setStartPosition(const QPoint& pos);
+
+    /**
+     * @brief 设置棋盘尺寸（宽 x 高，可以是矩形）
+     * 清除路径、起点与障碍；演示期间或边长超出 1~MAX_BOARD_SIZE 时不生效。
+     * 该尺寸上不存在马的闭合回路时（Schwenk 定理）立即提示
+     * @return 是否已修改
+     */
+    bool setBoardSize(int width, int height);
+    int boardWidth() const { return m_boardWidth; }
+    int boardHeight() const { return m_boardHeight; }
+
+    /**
+     * @brief 开始骑士巡游计算与演示
+     * 需先设置有效起始位置，否则不生效；预检查证明无解的障碍布局直接提示原因，不启动计算
+     */
+    void startTour();
+
+    /**
+     * @brief 切换格子的障碍状态（被阻挡的格子不需要经过）
+     * 已有的路径与计算作废；起点未被阻挡时保留
+     * @param pos 棋盘坐标（0-based）
+     */
+    void toggleObstacle(const QPoint& pos);
+
+    /**
+     * @brief 设置巡游的棋子（马、骆驼、斑马、长颈鹿）
+     * 已有的路径与计算作废，起点与障碍保留；演示期间不生效
+     */
+    void setLeaper(LeaperType leaper);
+    LeaperType leaper() const { return m_tourOptions.leaper; }
+
+    /**
+     * @brief 重置棋盘状态
+     * 清空路径、步骤标记、动画状态，恢复初始状态
+     */
+    void reset();
+
+    /**
+     * @brief 设置动画演示速度
+     * @param level 速度等级（0=慢，1=中，2=快，3=极快），超出范围时取最近的等级
+     */
+    void setSpeed(int level);
+
+    /**
+     * @brief 设置任意播放速度（步/秒，可以是每秒数千步），播放位置保持连续
+     */
+    void setStepsPerSecond(double stepsPerSecond);
+
+    /**
+     * @brief 跳转到指定步骤（演示期间有效，可用于拖动进度条）
+     * 计算得到的路径 O(1)；载入的路径文件首次到达某一步时顺序解码到该步（之后 O(分段长度)）
+     * @param step 步骤序号（1~路径长度，超出范围时取最近的步骤）
+     */
+    void seek(qint64 step);
+
+    /**
+     * @brief 把当前路径保存为二进制路径文件（格式见 TourFile）
+     * @param fileName 文件名
+     * @return 是否成功（没有路径或写入失败时返回 false，并通过 statusChanged 提示）
+     */
+    bool saveTour(const QString& fileName);
+
+    /**
+     * @brief 载入路径文件并开始演示（棋盘尺寸取自文件，不受 MAX_BOARD_SIZE 限制）
+     * 文件以内存映射方式打开并在演示期间保持打开，不展开到内存：播放与绘制通过分段索引（PathChunkIndex）
+     * 按需解码，只读取到达的步骤与可见区域内的段。解码到棋盘外的格子时停止演示并提示文件损坏；
+     * 路径长度等于可走格子数时视为完整路径
+     * @param fileName 文件名
+     * @return 是否成功
+     */
+    bool loadTour(const QString& fileName);
+
+    /**
+     * @brief 暂停或继续动画演示
+     * @param paused true=暂停，false=继续
+     */
+    void setPaused(bool paused);
+
+signals:
+    /**
+     * @brief 状态更新信号
+     * 用于通知主窗口更新状态提示文本
+     * @param status 状态描述字符串
+     */
+    void statusChanged(const QString& status);
+
+    /**
+     * @brief 遍历完成信号
+     * 通知主窗口遍历结束（成功/失败）
+     * @param success 是否找到有效路径
+     */
+    void tourFinished(bool success);
+
+    /**
+     * @brief 开始按钮启用状态信号
+     * 通知主窗口启用/禁用开始按钮
+     * @param enabled true=启用，false=禁用
+     */
+    void startBtnEnabled(bool enabled);
+
+    /**
+     * @brief 暂停状态改变信号
+     * @param paused 当前是否暂停
+     */
+    void pausedChanged(bool paused);
+
+    /**
+     * @brief 路径计算状态改变信号
+     * 计算在工作线程执行，期间允许重置或重新选择起点以取消计算
+     * @param calculating 当前是否正在计算
+     */
+    void calculatingChanged(bool calculating);
+
+    /**
+     * @brief 搜索统计信号
+     * 每次路径计算结束后发出，与 statusChanged 的状态文本一起显示
+     * @param summary 统计摘要（节点数、回溯次数、最大深度等；未开启搜索统计时只有节点数与耗时）
+     */
+    void searchStatsChanged(const QString& summary);
+
+    /**
+     * @brief 播放进度信号（步骤变化时发出，每帧至多一次）
+     * @param step 当前步骤
+     * @param total 路径总步数（载入的路径文件可能超过 int 范围）
+     */
+    void playbackProgress(qint64 step, qint64 total);
+
+protected:
+    /**
+     * @brief 重写绘图事件
+     * 分层绘制：棋盘格用纹理画刷填充，路径/步骤数字来自可见区域的累积层（远景改用密度纹理），
+     * 只有当前位置与马的图标每帧绘制；只重绘 event 的脏区域
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+    /**
+     * @brief 重写鼠标点击事件
+     * 未运行时支持左键点击选择起始位置、Ctrl+左键切换障碍格子；右键或中键按下开始拖动平移视图
+     */
+    void mousePressEvent(QMouseEvent *event) override;
+
+    /**
+     * @brief 重写鼠标移动事件（拖动平移视图）
+     */
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+    /**
+     * @brief 重写鼠标释放事件（结束拖动）
+     */
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+    /**
+     * @brief 重写滚轮事件
+     * 以鼠标位置为中心缩放视图，缩小到整盘可见时自动回到适应窗口的视图
+     */
+    void wheelEvent(QWheelEvent *event) override;
+
+    /**
+     * @brief 重写窗口大小变化事件
+     * 适应窗口的视图随窗口重新计算缩放；用户缩放过的视图保持缩放与中心
+     */
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    /**
+     * @brief 动画帧定时器处理（按显示刷新率触发）
+     * 从播放时钟读出应到达的步骤，一帧内跨越的多步合并为一次重绘
+     */
+    void onAnimationTimeout();
+
+    /**
+     * @brief 工作线程路径计算完成处理
+     * 读取求解结果，转换为绘制数据并开始动画演示
+     */
+    void onTourCalculated();
+
+private:
+    // -------------------------- 初始化相关函数 --------------------------
+    /**
+     * @brief 初始化窗口基础配置
+     * 设置最小尺寸、窗口标题、鼠标指针等
+     */
+    void initWidget();
+
+    /**
+     * @brief 初始化动画定时器
+     * 设置默认间隔、连接超时信号
+     */
+    void initAnimationTimer();
+
+    /**
+     * @brief 加载马的图标图片
+     * 支持多路径 fallback，加载失败时创建默认图形
+     */
+    void loadKnightImage();
+
+    // -------------------------- 算法核心函数 --------------------------
+    /**
+     * @brief 路径计算（在工作线程异步执行）
+     * 复制求解选项并提交到线程池，结果通过 onTourCalculated 回到 GUI 线程
+     */
+    void calculateTour();
+
+    /**
+     * @brief 取消正在进行的路径计算
+     * 设置取消标志后立即返回，工作线程会在下一个搜索节点退出，旧结果被丢弃
+     */
+    void cancelCalculation();
+
+    /**
+     * @brief 检查坐标是否有效（在棋盘内）
+     * @param pos 待检查坐标
+     * @return true=有效，false=无效
+     */
+    bool isValidPos(const QPoint& pos) const;
+
+    /**
+     * @brief 生成求解结果的统计摘要文本
+     * @param result 求解结果
+     * @return 统计摘要
+     */
+    QString formatSearchStats(const TourResult& result) const;
+
+    /**
+     * @brief 预检查结论的提示文本
+     */
+    QString describeInfeasibility(Infeasibility reason) const;
+
+    /**
+     * @brief 格子是否被阻挡（障碍保存在求解选项中，按 x * height + y 下标；只有可编辑尺寸的棋盘有障碍）
+     */
+    bool isBlocked(const QPoint& pos) const
+    {
+        return !m_tourOptions.obstacles.empty() && m_tourOptions.obstacles.test(pos.x() * m_boardHeight + pos.y());
+    }
+
+    /**
+     * @brief 棋盘能否编辑（选择起点、设置障碍、计算路径）：边长不超过 MAX_BOARD_SIZE
+     * 更大的棋盘只来自路径文件，不分配逐格的步骤标记
+     */
+    bool isEditableSize() const { return m_boardWidth <= MAX_BOARD_SIZE && m_boardHeight <= MAX_BOARD_SIZE; }
+
+    /**
+     * @brief 可走的格子数（完整路径的长度）
+     */
+    qint64 freeSquareCount() const
+    {
+        return static_cast<qint64>(m_boardWidth) * m_boardHeight - m_tourOptions.obstacles.count();
+    }
+
+    // -------------------------- 视图相关函数 --------------------------
+    /**
+     * @brief 更新视图：适应窗口时重新计算缩放与中心；缩放或可见区域变化时使依赖视图的缓存失效
+     */
+    void ensureView();
+
+    /**
+     * @brief 整个棋盘恰好放入窗口时的缩放（像素/格，不小于一个像素时取整）
+     */
+    qreal fitZoom() const;
+
+    /**
+     * @brief 以 anchor（组件坐标）为不动点缩放视图
+     */
+    void zoomAt(const QPointF& anchor, qreal factor);
+
+    /**
+     * @brief 平移视图（delta 为组件坐标中的位移）
+     */
+    void panBy(const QPointF& delta);
+
+    /**
+     * @brief 把视图中心限制在棋盘范围内
+     */
+    void clampView();
+
+    /**
+     * @brief 是否处于远景（格子太小，路径以密度纹理显示）
+     */
+    bool isDensityMode() const { return m_zoom < LOD_CELL_SIZE; }
+
+    /**
+     * @brief 棋盘坐标（以格为单位）到组件坐标
+     */
+    QPointF toWidget(const QPointF& board) const;
+
+    /**
+     * @brief 组件坐标所在的格子（可能在棋盘外）
+     */
+    QPoint cellAt(const QPointF& widgetPos) const;
+
+    /**
+     * @brief 格子在组件坐标中的矩形
+     */
+    QRectF cellRect(const QPoint& pos) const;
+
+    /**
+     * @brief 与组件可见区域相交的格子范围（已限制在棋盘内，可能为空）
+     */
+    QRect visibleCells() const;
+
+    // -------------------------- 路径访问函数 --------------------------
+    /**
+     * @brief 是否在演示载入的路径文件（否则演示 m_path）
+     */
+    bool isFilePlayback() const { return m_tourFile != nullptr; }
+
+    /**
+     * @brief 演示路径的格子数
+     */
+    qint64 pathLength() const { return isFilePlayback() ? m_tourFile->length() : m_path.size(); }
+
+    /**
+     * @brief 演示路径的第 index 个格子（0-based；路径文件从最近的段首解码）
+     */
+    QPoint pathAt(qint64 index) const
+    {
+        return isFilePlayback() ? m_fileIndex.at(index) : m_path[static_cast<int>(index)];
+    }
+
+    /**
+     * @brief 按顺序访问演示路径的第 first ~ last 个格子（路径文件用游标顺序解码）
+     * @param visit 访问函数 void(qint64 index, const QPoint& pos)
+     */
+    template <typename Visitor>
+    void forEachStep(qint64 first, qint64 last, Visitor&& visit) const;
+
+    /**
+     * @brief 第 step 步格子上显示的数字：闭合回路演示结束后起点标记为 N+1（超出动画步骤，不显示）
+     */
+    qint64 stepMark(qint64 step) const { return step == 1 && m_returnedToStart ? pathLength() + 1 : step; }
+
+    /**
+     * @brief 清空步骤标记（可编辑尺寸按格分配，超大棋盘不分配）
+     */
+    void clearStepMarks();
+
+    /**
+     * @brief 路径文件解码到棋盘外的格子：停止演示并提示
+     * @param badStep 无效格子的下标（0-based）
+     */
+    void abortCorruptFile(qint64 badStep);
+
+    // -------------------------- 绘制相关函数 --------------------------
+    /**
+     * @brief 路径改变后重建空间索引与密度纹理，并使累积层失效
+     * 路径文件不建立线段空间索引，改由 m_fileIndex 随播放按需建立分段索引
+     */
+    void resetPathCaches();
+
+    /**
+     * @brief 创建与组件等大的透明图层（按设备像素比分配，高分屏不模糊）
+     */
+    QPixmap createLayer() const;
+
+    /**
+     * @brief 按当前缩放重新缩放马的图标（每个缩放比例只缩放一次，格子太小时不绘制图标）
+     */
+    void rebuildKnightSprite();
+
+    /**
+     * @brief 使路径与步骤数字累积层失效（路径被替换、重置或视图变化时调用）
+     */
+    void invalidatePathLayers();
+
+    /**
+     * @brief 把累积层补画到当前动画步骤
+     * 增量：只绘制上次同步之后新增且可见的线段与数字；
+     * 重建（图层失效、步骤回退或一次前进的步数多于可见格子数）：
+     * 用空间索引只取可见区域内的线段，只遍历可见格子的数字，代价只与视口有关
+     */
+    void syncPathLayers();
+
+    /**
+     * @brief 把密度纹理同步到当前动画步骤（前进时标记新格子，后退时撤销）
+     */
+    void syncDensity();
+
+    /**
+     * @brief 两个格子中心之间的线段（组件坐标）
+     */
+    QLineF pathLine(const QPoint& from, const QPoint& to) const;
+
+    /**
+     * @brief 绘制可见的棋盘格子（近景用 2x2 纹理画刷一次填充，远景用平均色）
+     * @param painter 绘图对象
+     */
+    void drawBoardGrid(QPainter& painter);
+
+    /**
+     * @brief 绘制可见的障碍格子（只遍历被阻挡的格子）
+     * @param painter 绘图对象
+     */
+    void drawObstacles(QPainter& painter);
+
+    /**
+     * @brief 远景下按缩放比例选择一层密度纹理，绘制可见区域
+     * @param painter 绘图对象
+     */
+    void drawDensity(QPainter& painter);
+
+    /**
+     * @brief 取步骤数字的预排版文本（按需生成并缓存，字号变化时整体失效）
+     * @param step 步骤序号
+     */
+    const QStaticText& stepLabel(qint64 step);
+
+    /**
+     * @brief 绘制一个步骤数字（格子左上角的圆形标记，文本来自 stepLabel 缓存）
+     * @param painter 绘图对象（已设置字体与画笔）
+     * @param pos 格子坐标
+     * @param step 步骤序号
+     */
+    void drawStepNumber(QPainter& painter, const QPoint& pos, qint64 step);
+
+    /**
+     * @brief 高亮当前动画位置（远景下至少 MIN_MARKER_SIZE 大小）
+     * @param painter 绘图对象
+     */
+    void drawCurrentPosition(QPainter& painter);
+
+    /**
+     * @brief 绘制马的图标（居中显示在当前位置，使用预先缩放的图标）
+     * @param painter 绘图对象
+     */
+    void drawKnightIcon(QPainter& painter);
+
+    /**
+     * @brief 格子的步骤标记
+     */
+    int& stepAt(const QPoint& pos) { return m_board[pos.y() * m_boardWidth + pos.x()]; }
+    int stepAt(const QPoint& pos) const { return m_board[pos.y() * m_boardWidth + pos.x()]; }
+
+    /**
+     * @brief 修改棋盘尺寸（同时修改求解选项并清除障碍，视图恢复为适应窗口）
+     */
+    void setBoardDimensions(int width, int height);
+
+    /**
+     * @brief 从第一步开始播放演示路径（计算完成或载入文件后调用）
+     */
+    void startPlayback();
+
+    /**
+     * @brief 把动画推进（或回退）到 step，并按经过的格子标记脏区域
+     * 路径文件先把分段索引扩展到 step，解码到棋盘外的格子时停止演示
+     */
+    void advanceTo(qint64 step);
+
+    /**
+     * @brief 动画结束处理
+     * 停止定时器、更新状态、通知主窗口
+     */
+    void finishAnimation();
+
+    // -------------------------- 成员变量 --------------------------
+    // 棋盘数据
+    int m_boardWidth = BOARD_SIZE;   // 棋盘宽度（格）
+    int m_boardHeight = BOARD_SIZE;  // 棋盘高度（格）
+    QVector<int> m_board;            // 步骤标记（按行存放；0=未访问，1~N=步骤，N+1=返回起点；只用于 m_path）
+    QVector<QPoint> m_path;                           // 遍历路径存储（计算得到的路径）
+    std::unique_ptr<TourFile> m_tourFile;             // 载入的路径文件（演示期间保持映射，为空表示演示 m_path）
+    PathChunkIndex m_fileIndex;                       // 路径文件的分段索引（随播放扩展）
+
+    // 状态变量
+    QPoint m_startPos = {-1, -1};    // 起始位置（默认无效）
+    QPoint m_currentPos = {-1, -1};  // 动画当前位置
+    bool m_isRunning = false;        // 是否正在演示动画
+    bool m_hasSolution = false;      // 是否找到有效路径
+    bool m_tourClosed = false;       // 路径是否为闭合回路（演示结束时回到起点）
+    bool m_returnedToStart = false;  // 闭合回路演示结束，已回到起点
+    qint64 m_animationStep = 0;      // 动画当前步骤索引
+    bool m_isPaused = false;        // 动画是否暂停
+    bool m_isCalculating = false;   // 是否正在工作线程计算路径
+
+    // 工具对象
+    TourOptions m_tourOptions;       // 求解选项（每次计算复制到工作线程）
+    SearchBudget m_searchBudget;     // 搜索预算（默认超时 MAX_BACKTRACK_TIME）
+    std::shared_ptr<TourCache> m_tourCache = std::make_shared<TourCache>(); // 闭合回路缓存（同尺寸的其他起点直接旋转得到）
+    QThreadPool m_tourPool;                        // 路径计算的工作线程（包括已被取代、尚未退出的计算）
+    QFutureWatcher<TourResult> m_tourWatcher;      // 工作线程计算结果监视
+    std::shared_ptr<std::atomic<bool>> m_cancelFlag; // 当前计算的取消标志
+    QTimer m_animationTimer;         // 动画帧定时器（显示刷新率）
+    PlaybackClock m_playbackClock;   // 播放时钟（墙钟时间 -> 步骤）
+    QPixmap m_knightPixmap;          // 马的图标图片
+
+    // 视图（缩放与平移）
+    qreal m_zoom = 0;                // 缩放（像素/格）
+    QPointF m_viewCenter;            // 组件中心对应的棋盘坐标（以格为单位）
+    bool m_fitView = true;           // 是否适应窗口（整盘可见，随窗口大小重新计算）
+    bool m_isPanning = false;        // 是否正在拖动平移
+    QPointF m_panAnchor;             // 拖动时上一次的鼠标位置
+
+    // 分层绘制缓存
+    QImage m_checkerTexture;         // 2x2 棋盘格纹理（画刷变换缩放到格子大小）
+    PathSpatialIndex m_pathIndex;    // 路径线段空间索引（路径改变时重建）
+    DensityPyramid m_density;        // 远景密度纹理
+    qint64 m_densityStep = 0;        // 密度纹理已同步到的步骤
+    QPixmap m_pathLayer;             // 路径线条累积层（可见区域）
+    QPixmap m_labelLayer;            // 步骤数字累积层（可见区域）
+    qint64 m_layerStep = -1;         // 累积层已绘制到的步骤（-1 表示需要重建）
+    bool m_layerClosed = false;      // 累积层是否已画出回到起点的线段
+    qreal m_layerZoom = 0;           // 累积层对应的视图（任一项变化时重建）
+    QPointF m_layerCenter;
+    QSize m_layerSize;
+    qreal m_layerRatio = 0;
+    QPixmap m_knightSprite;          // 按当前缩放好的马的图标
+    QFont m_labelFont;               // 步骤数字字体（随缩放变化，按半磅取整）
+    QHash<qint64, QStaticText> m_labelCache; // 步骤数字预排版缓存（步骤序号 -> 文本，至多 MAX_CACHED_LABELS 项）
+
+    // 绘图颜色配置（默认初始化，可在构造函数调整）
+    QColor m_lightColor = QColor(240, 217, 181);    // 浅色格子（#f0d9b5）
+    QColor m_darkColor = QColor(181, 136, 99);      // 深色格子（#b58863）
+    QColor m_selectedColor = QColor(100, 181, 246); // 选中起点颜色（#64b5f6）
+    QColor m_obstacleColor = QColor(66, 66, 66);    // 障碍格子颜色（#424242）
+    QColor m_pathColor = QColor(129, 199, 132);     // 路径颜色（#81c784）
+    QColor m_currentColor = QColor(255, 183, 77);   // 当前位置颜色（#ffb74d）
+};
+
+template <typename Visitor>
+void Chessboard::forEachStep(qint64 first, qint64 last, Visitor&& visit) const
+{
+    if (isFilePlayback()) {
+        m_fileIndex.forEach(first, last, visit);
+        return;
+    }
+    for (qint64 index = first; index <= last; index++) {
+        visit(index, m_path[static_cast<int>(index)]);
+    }
+}
+
+#endif // CHESSBOARD_H
@@ -0,0 +1,61 @@
+#include "densitypyramid.h"
+
+#include <algorithm>
+
+void DensityPyramid::reset(int boardWidth, int boardHeight, const QColor& color)
+{
+    m_boardWidth = boardWidth;
+    m_boardHeight = boardHeight;
+    m_color = color;
+    m_firstLevel = 0;
+    m_levels.clear();
+    if (boardWidth <= 0 || boardHeight <= 0) {
+        return;
+    }
+
+    // 逐层减半，直到整块棋盘只剩一个纹素；纹素过多的细层跳过
+    for (int shift = 0;; shift++) {
+        const int width = ((boardWidth - 1) >> shift) + 1;
+        const int height = ((boardHeight - 1) >> shift) + 1;
+        if (static_cast<qint64>(width) * height > MAX_TEXELS) {
+            m_firstLevel = shift + 1;
+            continue;
+        }
+        Level level;
+        level.image = QImage(width, height, QImage::Format_ARGB32_Premultiplied);
+        level.image.fill(Qt::transparent);
+        level.counts.fill(0, width * height);
+        m_levels.append(std::move(level));
+        if (width == 1 && height == 1) {
+            break;
+        }
+    }
+}
+
+int DensityPyramid::levelFor(qreal cellSize) const
+{
+    int level = m_firstLevel;
+    while (level + 1 < m_firstLevel + m_levels.size() && cellSize * (1 << level) < 1.0) {
+        level++;
+    }
+    return level;
+}
+
+void DensityPyramid::update(const QPoint& cell, int delta)
+{
+    for (int shift = m_firstLevel; shift < m_firstLevel + m_levels.size(); shift++) {
+        Level& level = m_levels[shift - m_firstLevel];
+        const int x = cell.x() >> shift;
+        const int y = cell.y() >> shift;
+        qint64& count = level.counts[y * level.image.width() + x];
+        count += delta;
+
+        // 边缘纹素覆盖的格子少于 4^shift 个，按实际格子数计算比例
+        const int span = 1 << shift;
+        const int cellsX = std::min(span, m_boardWidth - (x << shift));
+        const int cellsY = std::min(span, m_boardHeight - (y << shift));
+        QColor color = m_color;
+        color.setAlphaF(static_cast<qreal>(count) / (static_cast<qint64>(cellsX) * cellsY));
+        level.image.setPixel(x, y, qPremultiply(color.rgba()));
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef DENSITYPYRAMID_H
+#define DENSITYPYRAMID_H
+
+#include <QColor>
+#include <QImage>
+#include <QPoint>
+#include <QVector>
+
+/**
+ * @brief 已访问格子的密度纹理金字塔（远景细节层次）
+ * 第 k 层的每个纹素对应 2^k x 2^k 个格子，透明度为其中已访问格子的比例。
+ * 远景下一个像素覆盖许多格子，逐条画线既慢又看不清，改为按缩放比例选一层纹理贴图。
+ * 每访问一个格子只更新每层的一个纹素，O(层数)。
+ * 纹素数超过 MAX_TEXELS 的细层不分配（载入的超大棋盘），缩放到这些层时改用最细的已分配层
+ */
+class DensityPyramid
+{
+public:
+    static constexpr qint64 MAX_TEXELS = 2048 * 2048;
+
+    /**
+     * @brief 按棋盘尺寸分配各层并清空（所有格子未访问）
+     */
+    void reset(int boardWidth, int boardHeight, const QColor& color);
+
+    /**
+     * @brief 把格子标记为已访问 / 未访问
+     */
+    void add(const QPoint& cell) { update(cell, 1); }
+    void remove(const QPoint& cell) { update(cell, -1); }
+
+    int levelCount() const { return m_levels.size(); }
+
+    /**
+     * @brief 第 level 层纹理（一个纹素对应 1 << level 个格子边长，level 不小于 levelFor 的结果）
+     */
+    const QImage& image(int level) const { return m_levels[level - m_firstLevel].image; }
+
+    /**
+     * @brief 选择纹素不小于一个像素的最细一层（不细于已分配的最细一层）
+     * @param cellSize 一个格子在屏幕上的边长（像素）
+     */
+    int levelFor(qreal cellSize) const;
+
+private:
+    struct Level
+    {
+        QImage image;
+        QVector<qint64> counts; // 每个纹素中已访问的格子数（粗层的纹素可能覆盖超过 2^31 个格子）
+    };
+
+    void update(const QPoint& cell, int delta);
+
+    int m_boardWidth = 0;
+    int m_boardHeight = 0;
+    QColor m_color;
+    int m_firstLevel = 0;      // 已分配的最细一层
+    QVector<Level> m_levels;   // 第 m_firstLevel 层起的各层
+};
+
+#endif // DENSITYPYRAMID_H
@@ -0,0 +1,232 @@
+#include "mainwindow.h"
+#include "ui_mainwindow.h"
+
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QSignalBlocker>
+#include <QSpinBox>
+#include <QStatusBar>
+
+#include <limits>
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent)
+    , ui(new Ui::MainWindow)
+    , m_speedLevel(1) // 默认中等速度
+{
+    ui->setupUi(this);
+
+    // 初始化棋盘
+    m_chessboard = new Chessboard(this);
+
+    // 安全添加棋盘：检查 centralWidget 是否有布局
+    QLayout *layout = ui->centralWidget->layout();
+    if (!layout) {
+        layout = new QVBoxLayout(ui->centralWidget);
+        layout->setContentsMargins(0, 0, 0, 0);
+    }
+    layout->addWidget(m_chessboard);
+
+    // 播放进度条：拖动时暂停播放并跳转，松开后恢复
+    m_progressSlider = new QSlider(Qt::Horizontal, this);
+    m_progressSlider->setVisible(false);
+    layout->addWidget(m_progressSlider);
+
+    // 连接信号槽
+    connect(m_chessboard, &Chessboard::statusChanged, this, &MainWindow::updateStatus);
+    connect(m_chessboard, &Chessboard::tourFinished, this, &MainWindow::onTourFinished);
+    connect(m_chessboard, &Chessboard::startBtnEnabled, ui->startBtn, &QPushButton::setEnabled);
+    connect(m_chessboard, &Chessboard::pausedChanged, this, [this](bool paused) {
+        ui->pauseBtn->setText(paused ? "继续" : "暂停");
+        ui->speedBtn->setEnabled(paused); // 暂停时启用速度按钮，继续时禁用
+    });
+    connect(m_chessboard, &Chessboard::searchStatsChanged, this, [this](const QString& summary) {
+        statusBar()->showMessage(summary); // 搜索统计显示在状态栏，与状态提示文本同时可见
+    });
+    connect(m_chessboard, &Chessboard::playbackProgress, this, [this](qint64 step, qint64 total) {
+        const QSignalBlocker blocker(m_progressSlider); // 程序设置的进度不再触发跳转
+        m_progressScale = (total - 1) / std::numeric_limits<int>::max() + 1;
+        m_progressSlider->setRange(1, static_cast<int>((total - 1) / m_progressScale) + 1);
+        if (!m_progressSlider->isSliderDown()) {
+            m_progressSlider->setValue(static_cast<int>((step - 1) / m_progressScale) + 1);
+        }
+        m_progressSlider->setVisible(true);
+    });
+    connect(m_progressSlider, &QSlider::valueChanged, this, [this](int value) {
+        m_chessboard->seek((value - 1) * m_progressScale + 1);
+    });
+    connect(m_progressSlider, &QSlider::sliderPressed, this, [this]() {
+        m_resumeAfterScrub = ui->pauseBtn->text() != "继续";
+        if (m_resumeAfterScrub) {
+            m_chessboard->setPaused(true);
+        }
+    });
+    connect(m_progressSlider, &QSlider::sliderReleased, this, [this]() {
+        if (m_resumeAfterScrub) {
+            m_chessboard->setPaused(false);
+        }
+    });
+    connect(m_chessboard, &Chessboard::calculatingChanged, this, [this](bool calculating) {
+        ui->resetBtn->setEnabled(calculating); // 计算期间允许重置（取消计算），演示期间禁用
+    });
+
+    // 初始化UI状态
+    setWindowTitle("国际象棋马的遍历 - 哈密顿回路");
+    ui->startBtn->setEnabled(false);
+    ui->speedBtn->setText("速度：中等");
+    ui->pauseBtn->setVisible(false);
+    updateStatus("请选择起始位置");
+}
+
+MainWindow::~MainWindow()
+{
+    delete ui;
+}
+
+void MainWindow::on_startBtn_clicked()
+{
+    // 开始后：禁用 start,reset 和 speed，显示 pause
+    ui->resetBtn->setEnabled(false);
+    ui->startBtn->setEnabled(false);
+    ui->speedBtn->setEnabled(false);
+    ui->leaperBtn->setEnabled(false);
+    ui->pauseBtn->setVisible(true);
+    m_chessboard->startTour();
+}
+
+void MainWindow::on_actionOpen_triggered()
+{
+    const QString fileName = QFileDialog::getOpenFileName(this, "打开路径", QString(), "巡游路径 (*.ktr);;所有文件 (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    // 载入成功后直接开始演示，界面状态与开始按钮一致
+    if (m_chessboard->loadTour(fileName)) {
+        updateLeaperButton(); // 棋子取自文件
+        ui->leaperBtn->setEnabled(false);
+        ui->resetBtn->setEnabled(false);
+        ui->startBtn->setEnabled(false);
+        ui->speedBtn->setEnabled(false);
+        ui->pauseBtn->setVisible(true);
+    }
+}
+
+void MainWindow::on_actionSave_triggered()
+{
+    const QString fileName = QFileDialog::getSaveFileName(this, "保存路径", "tour.ktr", "巡游路径 (*.ktr)");
+    if (!fileName.isEmpty()) {
+        m_chessboard->saveTour(fileName);
+    }
+}
+
+void MainWindow::on_actionBoardSize_triggered()
+{
+    // 与重置按钮一致：演示期间不允许修改
+    if (!ui->resetBtn->isEnabled()) {
+        updateStatus("演示期间无法修改棋盘尺寸");
+        return;
+    }
+
+    // 宽、高分别设置（矩形棋盘），确认后先恢复初始界面状态再修改尺寸
+    QDialog dialog(this);
+    dialog.setWindowTitle("棋盘尺寸");
+    QFormLayout *form = new QFormLayout(&dialog);
+    QSpinBox *widthBox = new QSpinBox(&dialog);
+    QSpinBox *heightBox = new QSpinBox(&dialog);
+    widthBox->setRange(1, MAX_BOARD_SIZE);
+    heightBox->setRange(1, MAX_BOARD_SIZE);
+    widthBox->setValue(m_chessboard->boardWidth());
+    heightBox->setValue(m_chessboard->boardHeight());
+    form->addRow("宽（列数）：", widthBox);
+    form->addRow("高（行数）：", heightBox);
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    form->addRow(buttons);
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+
+    on_resetBtn_clicked();
+    m_chessboard->setBoardSize(widthBox->value(), heightBox->value());
+}
+
+void MainWindow::on_resetBtn_clicked()
+{
+    // 重置棋盘并恢复初始UI状态
+    m_chessboard->reset();
+    ui->pauseBtn->setText("暂停");
+    m_chessboard->setPaused(false);
+    ui->pauseBtn->setVisible(false);
+    m_progressSlider->setVisible(false);
+    ui->speedBtn->setText("速度：中等");
+    ui->speedBtn->setEnabled(true); // 重置后速度按钮必须启用
+    ui->leaperBtn->setEnabled(true);
+    m_speedLevel = 1;
+    m_chessboard->setSpeed(m_speedLevel);
+    // 注意：startBtn 状态由 Chessboard 通过 startBtnEnabled(false) 自动控制
+}
+
+void MainWindow::on_speedBtn_clicked()
+{
+    // 循环切换速度等级：0(慢) → 1(中) → 2(快) → 3(极快) → 0
+    m_speedLevel = (m_speedLevel + 1) % 4;
+    switch (m_speedLevel) {
+    case 0:
+        ui->speedBtn->setText("速度：慢速");
+        break;
+    case 1:
+        ui->speedBtn->setText("速度：中等");
+        break;
+    case 2:
+        ui->speedBtn->setText("速度：快速");
+        break;
+    case 3:
+        ui->speedBtn->setText("速度：极快");
+        break;
+    }
+    m_chessboard->setSpeed(m_speedLevel);
+}
+
+void MainWindow::on_leaperBtn_clicked()
+{
+    // 循环切换棋子：马(1,2) → 骆驼(1,3) → 斑马(2,3) → 长颈鹿(1,4) → 马
+    m_chessboard->setLeaper(static_cast<LeaperType>((static_cast<int>(m_chessboard->leaper()) + 1) % 4));
+    updateLeaperButton();
+}
+
+void MainWindow::updateLeaperButton()
+{
+    static const char* const LEAPER_TEXTS[] = {"棋子：马", "棋子：骆驼", "棋子：斑马", "棋子：长颈鹿"};
+    ui->leaperBtn->setText(LEAPER_TEXTS[static_cast<int>(m_chessboard->leaper())]);
+}
+
+void MainWindow::on_pauseBtn_clicked()
+{
+    // 切换暂停状态
+    ui->resetBtn->setEnabled(true);
+    bool currentlyPaused = (ui->pauseBtn->text() == "继续");
+    m_chessboard->setPaused(!currentlyPaused);
+}
+
+void MainWindow::updateStatus(const QString &status)
+{
+    ui->statusLabel->setText(status);
+}
+
+
+void MainWindow::onTourFinished(bool success)
+{
+    // 遍历结束：隐藏暂停按钮，启用 speedBtn resetBtn
+    ui->pauseBtn->setVisible(false);
+    m_progressSlider->setVisible(false);
+    ui->resetBtn->setEnabled(true);
+    ui->speedBtn->setEnabled(true);
+    ui->leaperBtn->setEnabled(true);
+    if (!success) {
+        ui->startBtn->setEnabled(true); // 失败时允许重新开始
+    }
+    // 成功时 startBtn 保持禁用（需先重置或选新起点）
+}
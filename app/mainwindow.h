@@ -2,6 +2,7 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QSlider>
 #include "chessboard.h"
 
 namespace Ui {
@@ -20,14 +21,23 @@ private slots:
     void on_startBtn_clicked();
     void on_resetBtn_clicked();
     void on_speedBtn_clicked();
+    void on_leaperBtn_clicked();
     void updateStatus(const QString& status);
     void onTourFinished(bool success);
     void on_pauseBtn_clicked();
+    void on_actionOpen_triggered();
+    void on_actionSave_triggered();
+    void on_actionBoardSize_triggered();
 
 private:
+    void updateLeaperButton(); // 按棋盘当前的棋子更新按钮文字
+
     Ui::MainWindow *ui;
     Chessboard *m_chessboard;
-    int m_speedLevel; // 0=慢,1=中,2=快
+    QSlider *m_progressSlider;  // 播放进度条（演示期间显示，可拖动跳转）
+    qint64 m_progressScale = 1; // 进度条每格对应的步数（超过 int 范围的长路径按比例缩小）
+    int m_speedLevel; // 0=慢,1=中,2=快,3=极快
+    bool m_resumeAfterScrub = false; // 拖动进度条结束后是否恢复播放
     bool m_isPaused = false;    // 是否暂停
 };
 
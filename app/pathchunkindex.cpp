@@ -0,0 +1,60 @@
+#include "pathchunkindex.h"
+
+void PathChunkIndex::reset(const TourFile* file)
+{
+    clear();
+    if (!file || !file->isOpen() || file->length() <= 0) {
+        return;
+    }
+    m_file = file;
+    m_last = file->start();
+    m_chunks.append({m_last, QRect(toPoint(m_last), QSize(1, 1))});
+    m_decoded = 1;
+}
+
+void PathChunkIndex::clear()
+{
+    m_file = nullptr;
+    m_chunks.clear();
+    m_decoded = 0;
+    m_last = Square();
+}
+
+// 顺序解码新增的格子：先校验在棋盘内，再并入所在段的包围盒（每 CHUNK_STEPS 格开始新的一段）
+bool PathChunkIndex::extendTo(qint64 step, qint64* badStep)
+{
+    if (!m_file) {
+        return false;
+    }
+    step = std::min<qint64>(step, m_file->length() - 1);
+    if (step < m_decoded) {
+        return true;
+    }
+
+    TourFile::Cursor cursor = m_file->cursor(m_decoded - 1, m_last);
+    while (cursor.step() < step && cursor.next()) {
+        const Square& sq = cursor.square();
+        if (sq.x < 0 || sq.x >= m_file->width() || sq.y < 0 || sq.y >= m_file->height()) {
+            if (badStep) {
+                *badStep = cursor.step();
+            }
+            m_decoded = cursor.step();
+            return false;
+        }
+        const QPoint pos = toPoint(sq);
+        if (cursor.step() % CHUNK_STEPS == 0) {
+            m_chunks.append({sq, QRect(toPoint(m_last), QSize(1, 1))});
+        }
+        m_chunks.last().bounds |= QRect(pos, QSize(1, 1));
+        m_last = sq;
+    }
+    m_decoded = cursor.step() + 1;
+    return true;
+}
+
+QPoint PathChunkIndex::at(qint64 step) const
+{
+    QPoint result(-1, -1);
+    forEach(step, step, [&result](qint64, const QPoint& pos) { result = pos; });
+    return result;
+}
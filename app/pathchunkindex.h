@@ -0,0 +1,124 @@
+#ifndef PATHCHUNKINDEX_H
+#define PATHCHUNKINDEX_H
+
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+
+#include <algorithm>
+
+#include "tourfile.h"
+
+/**
+ * @brief 路径文件的分段索引（随播放按需扩展）
+ * 路径按 CHUNK_STEPS 格分段，每段记录首格坐标与包围盒（包含上一段的末格，跨段的线段也落在包围盒内）。
+ * 索引只覆盖已经播放或跳转到的格子：扩展时用 TourFile::Cursor 顺序解码新增的部分，打开文件后不需要整体扫描；
+ * 查询只解码包围盒与可见区域相交的段，解码量取决于视口与路径的局部性，与路径总长无关。
+ * 每段 24 字节，约为展开路径（每格 8 字节的 QPoint 加 4 字节的步骤标记）的千分之一
+ */
+class PathChunkIndex
+{
+public:
+    static constexpr int CHUNK_STEPS = 4096;
+
+    /**
+     * @brief 为已打开的路径文件建立索引（只记录起点，O(1)；文件须在索引使用期间保持打开）
+     */
+    void reset(const TourFile* file);
+
+    void clear();
+
+    /**
+     * @brief 已建立索引的格子数（第 0 ~ decodedLength()-1 格）
+     */
+    qint64 decodedLength() const { return m_decoded; }
+
+    /**
+     * @brief 把索引扩展到覆盖第 0 ~ step 格（超出路径长度时取最后一格）
+     * @param badStep 输出：遇到棋盘外的格子时为该格下标
+     * @return 文件损坏（解码出棋盘外的格子）时返回 false
+     */
+    bool extendTo(qint64 step, qint64* badStep = nullptr);
+
+    /**
+     * @brief 第 step 格（从最近的段首解码，O(CHUNK_STEPS)）
+     */
+    QPoint at(qint64 step) const;
+
+    /**
+     * @brief 按顺序访问第 first ~ last 格（从不晚于 first 的最近段首开始解码，未建立索引的部分继续顺序解码）
+     * @param visit 访问函数 void(qint64 step, const QPoint& pos)
+     */
+    template <typename Visitor>
+    void forEach(qint64 first, qint64 last, Visitor&& visit) const;
+
+    /**
+     * @brief 枚举包围盒与 cells 相交的段中不超过 last 的格子（last 须已建立索引）
+     * @param visit 访问函数 void(qint64 step, const QPoint& from, const QPoint& pos)，
+     *              from 为上一格（第 0 格时与 pos 相同），线段 from->pos 由调用者按需绘制
+     */
+    template <typename Visitor>
+    void query(const QRect& cells, qint64 last, Visitor&& visit) const;
+
+private:
+    struct Chunk
+    {
+        Square first;   // 段首格子
+        QRect bounds;   // 本段所有格子与上一段末格的包围盒
+    };
+
+    static QPoint toPoint(const Square& sq) { return QPoint(sq.x, sq.y); }
+
+    const TourFile* m_file = nullptr;
+    QVector<Chunk> m_chunks;
+    qint64 m_decoded = 0;  // 已建立索引的格子数
+    Square m_last;         // 最后一个已建立索引的格子
+};
+
+template <typename Visitor>
+void PathChunkIndex::forEach(qint64 first, qint64 last, Visitor&& visit) const
+{
+    if (!m_file || m_chunks.isEmpty() || first < 0 || first > last) {
+        return;
+    }
+    const int chunk = static_cast<int>(std::min<qint64>(first / CHUNK_STEPS, m_chunks.size() - 1));
+    TourFile::Cursor cursor = m_file->cursor(static_cast<qint64>(chunk) * CHUNK_STEPS, m_chunks[chunk].first);
+    while (cursor.step() < first && cursor.next()) {
+    }
+    if (cursor.step() < first) {
+        return; // first 超出路径长度
+    }
+    do {
+        visit(static_cast<qint64>(cursor.step()), toPoint(cursor.square()));
+    } while (cursor.step() < last && cursor.next());
+}
+
+template <typename Visitor>
+void PathChunkIndex::query(const QRect& cells, qint64 last, Visitor&& visit) const
+{
+    last = std::min(last, m_decoded - 1);
+    if (!m_file || cells.isEmpty()) {
+        return;
+    }
+    for (int chunk = 0; chunk < m_chunks.size() && static_cast<qint64>(chunk) * CHUNK_STEPS <= last; chunk++) {
+        if (!m_chunks[chunk].bounds.intersects(cells)) {
+            continue;
+        }
+        const qint64 begin = static_cast<qint64>(chunk) * CHUNK_STEPS;
+        const qint64 end = std::min(begin + CHUNK_STEPS - 1, last);
+        TourFile::Cursor cursor = m_file->cursor(begin, m_chunks[chunk].first);
+        QPoint from = toPoint(cursor.square());
+        if (begin > 0) {
+            // 上一段的末格：段首格减去其前一步的走法
+            const MoveDelta& delta = m_file->move(begin - 1);
+            from -= QPoint(delta.dx, delta.dy);
+        }
+        do {
+            const QPoint pos = toPoint(cursor.square());
+            visit(static_cast<qint64>(cursor.step()), from, pos);
+            from = pos;
+        } while (cursor.step() < end && cursor.next());
+    }
+}
+
+#endif // PATHCHUNKINDEX_H
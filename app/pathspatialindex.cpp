@@ -0,0 +1,39 @@
+#include "pathspatialindex.h"
+
+// 两遍扫描：先统计每块的线段数，再按编号顺序填入（各块内自然升序）
+void PathSpatialIndex::build(const QVector<QPoint>& path, int boardWidth, int boardHeight)
+{
+    m_tilesX = (boardWidth + TILE_SIZE - 1) / TILE_SIZE;
+    m_tilesY = (boardHeight + TILE_SIZE - 1) / TILE_SIZE;
+    m_offsets.fill(0, m_tilesX * m_tilesY + 1);
+
+    for (int segment = 1; segment < path.size(); segment++) {
+        const QRect range = tileRange(path[segment - 1], path[segment]);
+        for (int ty = range.top(); ty <= range.bottom(); ty++) {
+            for (int tx = range.left(); tx <= range.right(); tx++) {
+                m_offsets[ty * m_tilesX + tx + 1]++;
+            }
+        }
+    }
+    for (int tile = 0; tile < m_tilesX * m_tilesY; tile++) {
+        m_offsets[tile + 1] += m_offsets[tile];
+    }
+
+    m_segments.resize(m_offsets.last());
+    QVector<int> cursor(m_offsets.begin(), m_offsets.end() - 1);
+    for (int segment = 1; segment < path.size(); segment++) {
+        const QRect range = tileRange(path[segment - 1], path[segment]);
+        for (int ty = range.top(); ty <= range.bottom(); ty++) {
+            for (int tx = range.left(); tx <= range.right(); tx++) {
+                m_segments[cursor[ty * m_tilesX + tx]++] = segment;
+            }
+        }
+    }
+}
+
+void PathSpatialIndex::clear()
+{
+    m_tilesX = m_tilesY = 0;
+    m_offsets.clear();
+    m_segments.clear();
+}
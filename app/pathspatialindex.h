@@ -0,0 +1,86 @@
+#ifndef PATHSPATIALINDEX_H
+#define PATHSPATIALINDEX_H
+
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+
+#include <algorithm>
+
+/**
+ * @brief 路径线段的均匀网格空间索引
+ * 棋盘按 TILE_SIZE x TILE_SIZE 个格子分块，每块按编号升序记录包围盒与之相交的线段
+ * （线段 i 连接 path[i-1] 与 path[i]）。马步线段的包围盒只有 2x3 个格子，每条线段至多落入 4 块，
+ * 因此索引大小与路径长度成正比，查询只访问与可见区域相交的块
+ */
+class PathSpatialIndex
+{
+public:
+    static constexpr int TILE_SIZE = 16;
+
+    /**
+     * @brief 为 path 建立索引（O(n)，path 改变后需要重建）
+     */
+    void build(const QVector<QPoint>& path, int boardWidth, int boardHeight);
+
+    void clear();
+
+    /**
+     * @brief 枚举包围盒与 cells 相交、编号不超过 lastSegment 的线段（每条线段只报告一次）
+     * @param path 建立索引时的路径
+     * @param cells 查询区域（格子坐标）
+     * @param lastSegment 最大线段编号（动画只显示已走过的线段）
+     * @param visit 访问函数 void(int segment)
+     */
+    template <typename Visitor>
+    void query(const QVector<QPoint>& path, const QRect& cells, int lastSegment, Visitor&& visit) const;
+
+private:
+    // 线段包围盒所覆盖的块范围
+    QRect tileRange(const QPoint& from, const QPoint& to) const
+    {
+        return QRect(QPoint(std::min(from.x(), to.x()) / TILE_SIZE, std::min(from.y(), to.y()) / TILE_SIZE),
+                     QPoint(std::max(from.x(), to.x()) / TILE_SIZE, std::max(from.y(), to.y()) / TILE_SIZE));
+    }
+
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+    QVector<int> m_offsets;    // 每块线段列表在 m_segments 中的起始位置（CSR 格式，末尾多一个）
+    QVector<int> m_segments;   // 按块连续存放的线段编号（块内升序）
+};
+
+template <typename Visitor>
+void PathSpatialIndex::query(const QVector<QPoint>& path, const QRect& cells, int lastSegment, Visitor&& visit) const
+{
+    if (m_tilesX == 0 || cells.isEmpty()) {
+        return;
+    }
+    const QRect tiles = QRect(QPoint(cells.left() / TILE_SIZE, cells.top() / TILE_SIZE),
+                              QPoint(cells.right() / TILE_SIZE, cells.bottom() / TILE_SIZE))
+                            .intersected(QRect(0, 0, m_tilesX, m_tilesY));
+    for (int ty = tiles.top(); ty <= tiles.bottom(); ty++) {
+        for (int tx = tiles.left(); tx <= tiles.right(); tx++) {
+            const int tile = ty * m_tilesX + tx;
+            for (int i = m_offsets[tile]; i < m_offsets[tile + 1]; i++) {
+                const int segment = m_segments[i];
+                if (segment > lastSegment) {
+                    break; // 块内升序，后面的线段都还没走到
+                }
+                // 跨块的线段只在它与查询区域相交的第一块中报告
+                const QPoint& from = path[segment - 1];
+                const QPoint& to = path[segment];
+                const QRect range = tileRange(from, to);
+                if (tx != std::max(range.left(), tiles.left()) || ty != std::max(range.top(), tiles.top())) {
+                    continue;
+                }
+                const QRect bounds(QPoint(std::min(from.x(), to.x()), std::min(from.y(), to.y())),
+                                   QPoint(std::max(from.x(), to.x()), std::max(from.y(), to.y())));
+                if (bounds.intersects(cells)) {
+                    visit(segment);
+                }
+            }
+        }
+    }
+}
+
+#endif // PATHSPATIALINDEX_H
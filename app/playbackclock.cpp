@@ -0,0 +1,49 @@
+#include "playbackclock.h"
+
+void PlaybackClock::start(double position)
+{
+    m_running = true;
+    seek(position);
+}
+
+void PlaybackClock::seek(double position)
+{
+    if (!m_timer.isValid()) {
+        m_timer.start();
+    }
+    m_anchorPosition = position;
+    m_anchorNs = m_timer.nsecsElapsed();
+}
+
+void PlaybackClock::pause()
+{
+    if (m_running) {
+        seek(position());
+        m_running = false;
+    }
+}
+
+void PlaybackClock::resume()
+{
+    if (!m_running) {
+        m_running = true;
+        seek(m_anchorPosition);
+    }
+}
+
+void PlaybackClock::setStepsPerSecond(double stepsPerSecond)
+{
+    if (stepsPerSecond <= 0) {
+        return;
+    }
+    seek(position());
+    m_stepsPerSecond = stepsPerSecond;
+}
+
+double PlaybackClock::position() const
+{
+    if (!m_running || !m_timer.isValid()) {
+        return m_anchorPosition;
+    }
+    return m_anchorPosition + (m_timer.nsecsElapsed() - m_anchorNs) * 1e-9 * m_stepsPerSecond;
+}
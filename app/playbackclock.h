@@ -0,0 +1,48 @@
+#ifndef PLAYBACKCLOCK_H
+#define PLAYBACKCLOCK_H
+
+#include <QElapsedTimer>
+
+/**
+ * @brief 与帧率无关的播放时钟：把墙钟时间映射为（小数）步骤位置
+ * position = 锚点位置 + 锚点之后经过的时间 x 速度。
+ * 改变速度、暂停、跳转时重新设置锚点，位置连续且 O(1)；
+ * 帧定时器只负责按显示刷新率采样，丢帧或定时器抖动不会影响播放进度
+ */
+class PlaybackClock
+{
+public:
+    /**
+     * @brief 从 position 开始计时（处于运行状态）
+     */
+    void start(double position);
+
+    /**
+     * @brief 跳转到 position（保持当前的运行/暂停状态）
+     */
+    void seek(double position);
+
+    void pause();
+    void resume();
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief 设置播放速度（步/秒，任意正数），当前位置保持不变
+     */
+    void setStepsPerSecond(double stepsPerSecond);
+    double stepsPerSecond() const { return m_stepsPerSecond; }
+
+    /**
+     * @brief 当前位置（步）
+     */
+    double position() const;
+
+private:
+    QElapsedTimer m_timer;            // 单调时钟
+    double m_anchorPosition = 0;      // 锚点位置（步）
+    qint64 m_anchorNs = 0;            // 锚点时刻
+    double m_stepsPerSecond = 2;      // 播放速度（步/秒）
+    bool m_running = false;
+};
+
+#endif // PLAYBACKCLOCK_H
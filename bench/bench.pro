@@ -0,0 +1,12 @@
+# 求解器基准测试（命令行程序，不依赖 Qt）：遍历棋盘尺寸、起点与求解策略，输出机器可读的统计结果
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+TARGET = knighttourbench
+
+# 求解引擎静态库
+include(../engine/engine.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,405 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "knighttoursolver.h"
+#include "portfoliosolver.h"
+#include "structuredtour.h"
+#include "tourfile.h"
+#include "tourvalidator.h"
+#include "warnsdorfftour.h"
+
+// 求解器基准测试：对每种棋盘尺寸的每个起点运行各求解策略，
+// 每个（策略，尺寸）输出一行 JSON（JSON Lines），便于脚本比较与回归检测。
+// --write-tour 模式不运行求解策略，而是把构造式闭合回路流式写入路径文件（大棋盘的端到端吞吐）
+
+namespace {
+
+/**
+ * @brief 求解策略
+ */
+enum class Strategy
+{
+    Warnsdorff,    // 无回溯的 Warnsdorff 单遍构造（WarnsdorffTour，按 tieBreak 选择同度数候选）
+    Backtracking,  // 单线程 Warnsdorff + 回溯
+    Portfolio,     // 多线程组合求解
+    Structured     // 分治构造的闭合回路（StructuredTour，仅马、受支持的尺寸）
+};
+
+struct StrategyInfo
+{
+    Strategy strategy;
+    const char* name;
+    TieBreak tieBreak;   // 仅用于 Warnsdorff
+};
+
+constexpr StrategyInfo STRATEGIES[] = {
+    {Strategy::Warnsdorff, "warnsdorff", TieBreak::Index},
+    {Strategy::Warnsdorff, "pohl", TieBreak::Pohl},
+    {Strategy::Warnsdorff, "fixed-order", TieBreak::FixedOrder},
+    {Strategy::Warnsdorff, "roth", TieBreak::Roth},
+    {Strategy::Backtracking, "backtracking", TieBreak::Index},
+    {Strategy::Portfolio, "portfolio", TieBreak::Index},
+    {Strategy::Structured, "structured", TieBreak::Index}
+};
+
+/**
+ * @brief 命令行配置
+ */
+struct BenchConfig
+{
+    std::vector<Square> sizes = {{6, 6}, {8, 8}, {10, 10}, {12, 12}, {16, 16}}; // 棋盘尺寸（x=宽，y=高）
+    std::vector<StrategyInfo> strategies = {std::begin(STRATEGIES), std::end(STRATEGIES)};
+    int timeLimitMs = MAX_BACKTRACK_TIME;         // 每次求解的超时时间
+    bool closed = true;                           // 是否要求闭合回路
+    int threads = 0;                              // 组合求解的实例数（0=全部硬件线程）
+    bool printRuns = false;                       // 是否输出每次运行的明细
+    bool forwardChecking = true;                  // 回溯搜索是否使用前向检查
+    int connectivityInterval = 0;                 // 连通性检查间隔（0=不检查）
+    int tableMegabytes = 0;                       // 无解状态表大小（MB，0=不使用；同一尺寸的各起点共享）
+    LeaperType leaper = LeaperType::Knight;       // 棋子
+    std::vector<Square> obstacles;                // 障碍格子（超出当前棋盘的坐标忽略）
+    std::string tourFile;                         // 非空时只把构造式回路流式写入该文件（多个尺寸依次覆盖）
+};
+
+/**
+ * @brief 单次运行的测量结果
+ */
+struct RunSample
+{
+    Square start;
+    double elapsedMs = 0;        // 墙钟时间（微秒精度）
+    StopReason stopReason = StopReason::None;
+    long long nodes = 0;
+    long long backtracks = 0;    // 撤销的节点数
+    bool invalid = false;        // 报告成功但路径未通过校验
+};
+
+void printUsage(const char* program)
+{
+    std::fprintf(stderr,
+                 "用法：%s [--sizes 6,8,5x6] [--strategies warnsdorff,pohl,fixed-order,roth,backtracking,portfolio,structured]\n"
+                 "          [--time-limit ms] [--open] [--threads n] [--runs]\n"
+                 "          [--no-forward-checking] [--connectivity interval] [--tt-mb n]\n"
+                 "          [--leaper knight|camel|zebra|giraffe] [--obstacles x:y,x:y]\n"
+                 "       %s --sizes 10000 --write-tour file.ktr\n",
+                 program, program);
+}
+
+// 解析逗号分隔的列表
+std::vector<std::string> splitList(const char* text)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+bool parseArgs(int argc, char* argv[], BenchConfig& config)
+{
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--sizes") == 0 && hasValue) {
+            config.sizes.clear();
+            // "8" 表示 8x8，"5x6" 表示宽 5、高 6
+            for (const std::string& item : splitList(argv[++i])) {
+                const size_t separator = item.find('x');
+                const int width = std::atoi(item.c_str());
+                const int height = separator == std::string::npos ? width : std::atoi(item.c_str() + separator + 1);
+                if (width < 1 || height < 1) {
+                    return false;
+                }
+                config.sizes.push_back(Square(width, height));
+            }
+        } else if (std::strcmp(arg, "--strategies") == 0 && hasValue) {
+            config.strategies.clear();
+            for (const std::string& item : splitList(argv[++i])) {
+                auto it = std::find_if(std::begin(STRATEGIES), std::end(STRATEGIES),
+                                       [&item](const StrategyInfo& info) { return item == info.name; });
+                if (it == std::end(STRATEGIES)) {
+                    return false;
+                }
+                config.strategies.push_back(*it);
+            }
+        } else if (std::strcmp(arg, "--time-limit") == 0 && hasValue) {
+            config.timeLimitMs = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            config.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--open") == 0) {
+            config.closed = false;
+        } else if (std::strcmp(arg, "--runs") == 0) {
+            config.printRuns = true;
+        } else if (std::strcmp(arg, "--no-forward-checking") == 0) {
+            config.forwardChecking = false;
+        } else if (std::strcmp(arg, "--connectivity") == 0 && hasValue) {
+            config.connectivityInterval = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--tt-mb") == 0 && hasValue) {
+            config.tableMegabytes = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--obstacles") == 0 && hasValue) {
+            // "2:3,4:5" 表示 (2,3) 与 (4,5) 两个障碍格子，对每个尺寸都生效
+            for (const std::string& item : splitList(argv[++i])) {
+                const size_t separator = item.find(':');
+                if (separator == std::string::npos) {
+                    return false;
+                }
+                const int x = std::atoi(item.c_str());
+                const int y = std::atoi(item.c_str() + separator + 1);
+                if (x < 0 || y < 0) {
+                    return false;
+                }
+                config.obstacles.push_back(Square(x, y));
+            }
+        } else if (std::strcmp(arg, "--write-tour") == 0 && hasValue) {
+            config.tourFile = argv[++i];
+        } else if (std::strcmp(arg, "--leaper") == 0 && hasValue) {
+            const char* name = argv[++i];
+            bool found = false;
+            for (LeaperType leaper : {LeaperType::Knight, LeaperType::Camel, LeaperType::Zebra, LeaperType::Giraffe}) {
+                if (std::strcmp(name, leaperName(leaper)) == 0) {
+                    config.leaper = leaper;
+                    found = true;
+                }
+            }
+            if (!found) {
+                std::fprintf(stderr, "未知的棋子：%s\n", name);
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return !config.sizes.empty() && !config.strategies.empty();
+}
+
+// 最近秩百分位数（samples 已排序且非空）
+double percentile(const std::vector<double>& samples, double p)
+{
+    const size_t rank = static_cast<size_t>(p * samples.size() + 0.999999);
+    return samples[std::min(samples.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+RunSample runOnce(const StrategyInfo& info, KnightTourSolver& solver, PortfolioSolver& portfolio,
+                  WarnsdorffTour& greedy, const StructuredTour& structured, TourValidator& validator, const Square& start,
+                  const SearchBudget& budget, const TourOptions& options)
+{
+    const int squares = options.squareCount();
+    const auto begin = std::chrono::steady_clock::now();
+    TourResult result;
+    switch (info.strategy) {
+    case Strategy::Warnsdorff:
+        result = greedy.solve(start);
+        break;
+    case Strategy::Backtracking:
+        result = solver.solve(start, budget);
+        break;
+    case Strategy::Portfolio:
+        result = portfolio.solve(start, budget);
+        break;
+    case Strategy::Structured:
+        // 构造式回路只对无障碍的马有定义，其他情况按未求解计入
+        if (options.leaper == LeaperType::Knight && options.obstacles.empty()) {
+            result = structured.solve(start);
+        }
+        break;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    RunSample sample;
+    sample.start = start;
+    sample.elapsedMs = std::chrono::duration<double, std::milli>(end - begin).count();
+    sample.stopReason = result.stopReason;
+    sample.nodes = result.nodes;
+    // 校验不计入耗时：每条成功的路径都必须是完整的巡游
+    sample.invalid = result.success && !validator.validate(result.path, options.closed).ok();
+    if (info.strategy == Strategy::Warnsdorff || info.strategy == Strategy::Structured) {
+        sample.backtracks = 0; // 单遍构造从不撤销
+    } else if (result.stats.enabled) {
+        sample.backtracks = result.stats.backtracks;
+    } else {
+        // 未开启搜索统计时估算：成功时路径上的节点未被撤销，其余节点均已回溯
+        sample.backtracks = result.success ? std::max(0LL, result.nodes - squares) : result.nodes;
+    }
+    return sample;
+}
+
+void runBenchmark(const BenchConfig& config, const StrategyInfo& info, int width, int height)
+{
+    TourOptions options;
+    options.width = width;
+    options.height = height;
+    options.closed = config.closed;
+    options.forwardChecking = config.forwardChecking;
+    options.connectivityInterval = config.connectivityInterval;
+    options.leaper = config.leaper;
+    for (const Square& sq : config.obstacles) {
+        if (sq.x < width && sq.y < height) {
+            options.obstacles.set(sq.x * height + sq.y);
+        }
+    }
+
+    SearchBudget budget;
+    budget.timeLimitMs = config.timeLimitMs;
+
+    KnightTourSolver solver(options);
+    PortfolioSolver portfolio(options, config.threads);
+    WarnsdorffTour greedy(options, info.tieBreak);
+    StructuredTour structured(width, height);
+    std::unique_ptr<TranspositionTable> table;
+    if (config.tableMegabytes > 0) {
+        table = std::make_unique<TranspositionTable>(config.tableMegabytes);
+        solver.setTranspositionTable(table.get());
+        portfolio.setTranspositionTable(table.get());
+    }
+    TourValidator validator(width, height, config.leaper, options.obstacles);
+    const int squares = width * height;
+
+    std::vector<RunSample> samples;
+    samples.reserve(squares);
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+            // 障碍格子不能作为起点
+            if (options.obstacles.test(x * height + y)) {
+                continue;
+            }
+            samples.push_back(runOnce(info, solver, portfolio, greedy, structured, validator, Square(x, y), budget,
+                                      options));
+        }
+    }
+    if (samples.empty()) {
+        return; // 所有格子都是障碍
+    }
+
+    std::vector<double> times;
+    long long nodes = 0;
+    long long backtracks = 0;
+    double totalMs = 0;
+    int solved = 0;
+    int exhausted = 0;
+    int deadEnds = 0;
+    int timeouts = 0;
+    int invalid = 0;
+    for (const RunSample& sample : samples) {
+        times.push_back(sample.elapsedMs);
+        nodes += sample.nodes;
+        backtracks += sample.backtracks;
+        totalMs += sample.elapsedMs;
+        solved += sample.stopReason == StopReason::Solved;
+        exhausted += sample.stopReason == StopReason::Exhausted;
+        deadEnds += sample.stopReason == StopReason::DeadEnd;
+        timeouts += sample.stopReason == StopReason::Deadline;
+        invalid += sample.invalid;
+
+        if (config.printRuns) {
+            std::printf("{\"type\":\"run\",\"strategy\":\"%s\",\"width\":%d,\"height\":%d,\"x\":%d,\"y\":%d,"
+                        "\"ms\":%.3f,\"stop\":\"%s\",\"nodes\":%lld,\"backtracks\":%lld}\n",
+                        info.name, width, height, sample.start.x, sample.start.y, sample.elapsedMs,
+                        stopReasonName(sample.stopReason), sample.nodes, sample.backtracks);
+        }
+    }
+    std::sort(times.begin(), times.end());
+
+    const int runs = static_cast<int>(samples.size());
+    const double nodesPerSec = totalMs > 0 ? nodes / (totalMs / 1000.0) : 0.0;
+    // 耗时百分位数包含未成功的运行（按实际耗时计入），超时直接体现在 p99/max 上
+    std::printf("{\"type\":\"summary\",\"strategy\":\"%s\",\"leaper\":\"%s\",\"width\":%d,\"height\":%d,\"obstacles\":%d,\"closed\":%s,"
+                "\"time_limit_ms\":%d,\"runs\":%d,\"solved\":%d,\"invalid\":%d,\"exhausted\":%d,\"dead_ends\":%d,"
+                "\"timeouts\":%d,"
+                "\"timeout_rate\":%.4f,\"p50_ms\":%.3f,\"p99_ms\":%.3f,\"max_ms\":%.3f,"
+                "\"nodes\":%lld,\"nodes_per_sec\":%.0f,\"backtracks\":%lld,\"backtracks_counted\":%s,"
+                "\"tt_hits\":%lld,\"tt_misses\":%lld}\n",
+                info.name, leaperName(config.leaper), width, height, options.obstacles.count(), config.closed ? "true" : "false", config.timeLimitMs, runs, solved,
+                invalid, exhausted, deadEnds, timeouts, runs > 0 ? static_cast<double>(timeouts) / runs : 0.0,
+                percentile(times, 0.50), percentile(times, 0.99), times.back(), nodes, nodesPerSec,
+                backtracks, SEARCH_STATS_ENABLED ? "true" : "false", table ? table->hits() : 0LL,
+                table ? table->misses() : 0LL);
+    std::fflush(stdout);
+}
+
+/**
+ * @brief 把构造式闭合回路从 (0,0) 流式写入路径文件，并重新打开文件确认长度与闭合标志
+ *
+ * 整个过程不保存路径，内存占用与棋盘大小无关，用于 10000x10000 这类求解器无法处理的规模。
+ */
+bool writeStructuredTour(const BenchConfig& config, int width, int height)
+{
+    const StructuredTour structured(width, height);
+    if (!structured.isValid()) {
+        std::fprintf(stderr, "构造式回路不支持 %dx%d\n", width, height);
+        return false;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    TourFileWriter writer;
+    if (!writer.open(config.tourFile, width, height)) {
+        std::fprintf(stderr, "%s\n", writer.errorString().c_str());
+        return false;
+    }
+    bool ok = true;
+    const long long written = structured.walk(Square(0, 0), [&writer, &ok](const Square& sq) {
+        ok = writer.append(sq);
+        return ok;
+    });
+    if (!ok || !writer.finish()) {
+        std::fprintf(stderr, "%s\n", writer.errorString().c_str());
+        return false;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double elapsedMs = std::chrono::duration<double, std::milli>(end - begin).count();
+
+    TourFile file;
+    if (!file.open(config.tourFile)) {
+        std::fprintf(stderr, "%s\n", file.errorString().c_str());
+        return false;
+    }
+    const bool complete = file.length() == structured.squareCount() && file.isClosed();
+
+    std::printf("{\"type\":\"write\",\"strategy\":\"structured\",\"width\":%d,\"height\":%d,"
+                "\"squares\":%lld,\"complete\":%s,\"ms\":%.3f,\"squares_per_sec\":%.0f}\n",
+                width, height, written, complete ? "true" : "false", elapsedMs,
+                elapsedMs > 0 ? written / (elapsedMs / 1000.0) : 0.0);
+    std::fflush(stdout);
+    return complete;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (!config.tourFile.empty()) {
+        if (config.leaper != LeaperType::Knight || !config.obstacles.empty()) {
+            std::fprintf(stderr, "构造式回路只支持无障碍的马\n");
+            return 1;
+        }
+        for (const Square& size : config.sizes) {
+            if (!writeStructuredTour(config, size.x, size.y)) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    for (const StrategyInfo& info : config.strategies) {
+        for (const Square& size : config.sizes) {
+            runBenchmark(config, info, size.x, size.y);
+        }
+    }
+    return 0;
+}
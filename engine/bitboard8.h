@@ -0,0 +1,151 @@
+#ifndef BITBOARD8_H
+#define BITBOARD8_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "leaper.h"
+#include "tourtypes.h"
+
+// 8x8 棋盘的位棋盘表示：第 (x * 8 + y) 位对应格子 (x, y)，
+// 8x8 时与求解器的一维下标及 Warnsdorff 排序序号保持一致；
+// 宽、高都不超过 8 的棋盘嵌入左下角，其余位为边界哨兵（见 bitboardBoardMask）
+using Bitboard = std::uint64_t;
+
+constexpr int BITBOARD_SIZE = 8;
+constexpr int BITBOARD_SQUARES = BITBOARD_SIZE * BITBOARD_SIZE;
+
+constexpr int bitboardIndex(int x, int y) { return x * BITBOARD_SIZE + y; }
+constexpr Bitboard bitboardBit(int index) { return Bitboard(1) << index; }
+
+/**
+ * @brief width x height 棋盘（宽、高都不超过 8）嵌入位棋盘后棋盘内格子的掩码
+ * 掩码之外的位是边界哨兵：搜索时始终视为已访问，走法生成与度数计算都不需要边界检查
+ */
+constexpr Bitboard bitboardBoardMask(int width, int height)
+{
+    const Bitboard column = height >= BITBOARD_SIZE ? 0xFF : (Bitboard(1) << height) - 1;
+    Bitboard mask = 0;
+    for (int x = 0; x < width && x < BITBOARD_SIZE; x++) {
+        mask |= column << (x * BITBOARD_SIZE);
+    }
+    return mask;
+}
+
+static_assert(bitboardBoardMask(8, 8) == ~Bitboard(0), "8x8 棋盘没有哨兵位");
+static_assert(bitboardBoardMask(5, 6) == 0x3F3F3F3F3FULL, "5x6 棋盘每列低 6 位");
+
+/**
+ * @brief 8x8 棋盘上跳子的攻击表（编译期生成，每种跳子一张）
+ * masks[sq] 为从 sq 出发一步可达的全部格子
+ */
+template <class Piece>
+struct AttackTable8
+{
+    Bitboard masks[BITBOARD_SQUARES] = {};
+
+    constexpr AttackTable8()
+    {
+        for (int x = 0; x < BITBOARD_SIZE; x++) {
+            for (int y = 0; y < BITBOARD_SIZE; y++) {
+                Bitboard mask = 0;
+                for (const MoveDelta& dir : Piece::directions) {
+                    const int nx = x + dir.dx;
+                    const int ny = y + dir.dy;
+                    if (nx >= 0 && nx < BITBOARD_SIZE && ny >= 0 && ny < BITBOARD_SIZE) {
+                        mask |= bitboardBit(bitboardIndex(nx, ny));
+                    }
+                }
+                masks[bitboardIndex(x, y)] = mask;
+            }
+        }
+    }
+
+    constexpr Bitboard operator[](int index) const { return masks[index]; }
+};
+
+template <class Piece>
+inline constexpr AttackTable8<Piece> LEAPER_ATTACKS_8{};
+
+inline constexpr const AttackTable8<KnightLeaper>& KNIGHT_ATTACKS_8 = LEAPER_ATTACKS_8<KnightLeaper>;
+
+/**
+ * @brief y 方向移动 dy 后仍在棋盘内的起点格子（防止跨列回绕）
+ */
+constexpr Bitboard bitboardRowsFor(int dy)
+{
+    Bitboard mask = 0;
+    for (int x = 0; x < BITBOARD_SIZE; x++) {
+        for (int y = 0; y < BITBOARD_SIZE; y++) {
+            if (y + dy >= 0 && y + dy < BITBOARD_SIZE) {
+                mask |= bitboardBit(bitboardIndex(x, y));
+            }
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief 一组格子一步可达的全部格子（按方向整体移位，用于连通性检查的洪泛）
+ * x 方向越界的位在移位时自然移出，y 方向先用掩码去掉会回绕的格子；
+ * 移位量与掩码都是编译期常量，8 个方向完全展开
+ */
+template <class Piece>
+inline Bitboard leaperSpread8(Bitboard squares)
+{
+    Bitboard spread = 0;
+    forEachLeap<Piece>([&](auto i) {
+        constexpr MoveDelta dir = Piece::directions[decltype(i)::value];
+        constexpr int shift = dir.dx * BITBOARD_SIZE + dir.dy;
+        constexpr Bitboard rows = bitboardRowsFor(dir.dy);
+        const Bitboard movable = squares & rows;
+        if constexpr (shift > 0) {
+            spread |= movable << shift;
+        } else {
+            spread |= movable >> -shift;
+        }
+    });
+    return spread;
+}
+
+static_assert(KNIGHT_ATTACKS_8[0] == (bitboardBit(bitboardIndex(1, 2)) | bitboardBit(bitboardIndex(2, 1))),
+              "角落格子只有两个可达格子");
+static_assert(LEAPER_ATTACKS_8<GiraffeLeaper>[0] == (bitboardBit(bitboardIndex(1, 4)) | bitboardBit(bitboardIndex(4, 1))),
+              "长颈鹿在角落同样只有两个可达格子");
+
+/**
+ * @brief 统计位数（Warnsdorff 度数）
+ */
+inline int popCount(Bitboard bits)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(bits));
+#elif defined(__POPCNT__) || defined(__ARM_NEON)
+    return __builtin_popcountll(bits);
+#else
+    // 无硬件 popcnt 时 __builtin_popcountll 会退化为库函数调用，改用 SWAR 计数
+    bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+    bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((bits * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief 最低位的下标（bits 不能为 0）
+ */
+inline int lowestBitIndex(Bitboard bits)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+#endif // BITBOARD8_H
@@ -0,0 +1,29 @@
+#ifndef BOARDSYMMETRY_H
+#define BOARDSYMMETRY_H
+
+#include "tourtypes.h"
+
+// 棋盘的对称变换（二面体群的元素）：第 0 位翻转 x，第 1 位翻转 y，第 2 位再转置（仅正方形棋盘）；
+// 0 为恒等变换。马步（及任意 (a, b) 跳子的一步）在所有对称变换下保持不变，因此路径的像仍是合法路径（闭合性也保持不变）
+
+/**
+ * @brief 棋盘的对称变换数（正方形 8，矩形 4）
+ */
+constexpr int boardSymmetryCount(int width, int height)
+{
+    return width == height ? 8 : 4;
+}
+
+/**
+ * @brief 对格子施加对称变换
+ */
+constexpr Square transformSquare(const Square& sq, int width, int height, int symmetry)
+{
+    const int x = (symmetry & 1) ? width - 1 - sq.x : sq.x;
+    const int y = (symmetry & 2) ? height - 1 - sq.y : sq.y;
+    return (symmetry & 4) ? Square(y, x) : Square(x, y);
+}
+
+static_assert(transformSquare(Square(0, 1), 8, 8, 5) == Square(1, 7), "先翻转 x 再转置");
+
+#endif // BOARDSYMMETRY_H
@@ -0,0 +1,21 @@
+# 供依赖引擎的子项目 include，统一头文件路径与静态库链接配置
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+# 并行求解器使用 std::thread
+CONFIG += thread
+
+# 搜索统计开关，与 engine.pro 保持一致
+CONFIG(debug, debug|release)|search_stats: DEFINES += KNIGHTTOUR_SEARCH_STATS
+
+ENGINE_OUT = $$shadowed($$PWD)
+
+win32:CONFIG(release, debug|release): ENGINE_LIB_DIR = $$ENGINE_OUT/release
+else:win32:CONFIG(debug, debug|release): ENGINE_LIB_DIR = $$ENGINE_OUT/debug
+else: ENGINE_LIB_DIR = $$ENGINE_OUT
+
+LIBS += -L$$ENGINE_LIB_DIR -lknighttourengine
+
+win32-g++: PRE_TARGETDEPS += $$ENGINE_LIB_DIR/libknighttourengine.a
+else:win32:!win32-g++: PRE_TARGETDEPS += $$ENGINE_LIB_DIR/knighttourengine.lib
+else: PRE_TARGETDEPS += $$ENGINE_LIB_DIR/libknighttourengine.a
@@ -0,0 +1,44 @@
+# 骑士巡游求解引擎（静态库，不依赖 Qt，可用于批量计算与性能分析）
+TEMPLATE = lib
+CONFIG += staticlib c++17 thread
+CONFIG -= qt
+
+# 搜索统计（SearchStats）：调试构建默认开启，发布构建可用 CONFIG+=search_stats 开启；
+# 关闭时统计代码全部编译掉。引擎与使用方须一致，因此同样写在 engine.pri 中
+CONFIG(debug, debug|release)|search_stats: DEFINES += KNIGHTTOUR_SEARCH_STATS
+
+TARGET = knighttourengine
+
+# 位棋盘度数计算依赖 popcount，x86-64 上启用硬件指令
+contains(QT_ARCH, x86_64):!msvc: QMAKE_CXXFLAGS += -mpopcnt
+
+SOURCES += \
+    knighttoursolver.cpp \
+    paralleltreesearch.cpp \
+    portfoliosolver.cpp \
+    structuredtour.cpp \
+    tourcache.cpp \
+    tourfeasibility.cpp \
+    tourenumerator.cpp \
+    tourfile.cpp \
+    tourvalidator.cpp \
+    transpositiontable.cpp \
+    warnsdorfftour.cpp
+
+HEADERS += \
+    bitboard8.h \
+    boardsymmetry.h \
+    knighttoursolver.h \
+    leaper.h \
+    moveordering.h \
+    paralleltreesearch.h \
+    portfoliosolver.h \
+    structuredtour.h \
+    tourcache.h \
+    tourfeasibility.h \
+    tourenumerator.h \
+    tourfile.h \
+    tourtypes.h \
+    tourvalidator.h \
+    transpositiontable.h \
+    warnsdorfftour.h
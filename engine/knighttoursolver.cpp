@@ -0,0 +1,749 @@
+#include "knighttoursolver.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "tourfeasibility.h"
+
+KnightTourSolver::KnightTourSolver(const TourOptions& options)
+    : m_options(options)
+{
+}
+
+void KnightTourSolver::setOptions(const TourOptions& options)
+{
+    m_options = options;
+}
+
+// 检查坐标是否有效（工具函数，减少重复代码）
+bool KnightTourSolver::isValidPos(const Square& pos) const
+{
+    return inBoard(pos.x, pos.y);
+}
+
+// 求解入口：从单个起点求解（缓存命中时不搜索，预检查证明无解时不搜索，否则搜索并保存）
+TourResult KnightTourSolver::solve(const Square& start, const SearchBudget& budget)
+{
+    TourResult result;
+    if (m_tourCache && m_tourCache->lookup(m_options, start, result)) {
+        return result;
+    }
+    const Infeasibility infeasibility = checkTourFeasibility(m_options, start);
+    if (infeasibility != Infeasibility::None) {
+        result.stopReason = infeasibility == Infeasibility::InvalidStart ? StopReason::None : StopReason::Exhausted;
+        return result;
+    }
+
+    result = solveFrom(std::vector<Square>(1, start), budget);
+    if (m_tourCache) {
+        m_tourCache->store(m_options, result);
+    }
+    return result;
+}
+
+// 从前缀求解：找到第一条路径即返回
+TourResult KnightTourSolver::solveFrom(const std::vector<Square>& prefix, const SearchBudget& budget)
+{
+    m_onTour = nullptr;
+    if (!beginSearch(prefix, budget)) {
+        return TourResult();
+    }
+    return runSearch(m_totalSteps - 1);
+}
+
+// 从前缀枚举全部路径
+TourResult KnightTourSolver::enumerateFrom(const std::vector<Square>& prefix, const TourCallback& onTour,
+                                           const SearchBudget& budget)
+{
+    m_onTour = &onTour;
+    TourResult result;
+    if (beginSearch(prefix, budget)) {
+        result = runSearch(m_totalSteps - 1);
+    }
+    m_onTour = nullptr;
+    return result;
+}
+
+// 展开前沿：把目标深度设为前缀末端 + depth，到达即记录（不检查闭合）
+TourResult KnightTourSolver::expandFrontier(const std::vector<Square>& prefix, int depth,
+                                            std::vector<std::vector<Square>>& frontier)
+{
+    frontier.clear();
+    const TourCallback collect = [&frontier](const std::vector<Square>& path) {
+        frontier.push_back(path);
+        return true;
+    };
+
+    m_onTour = &collect;
+    const SplitCallback* const onSplit = m_onSplit;
+    m_onSplit = nullptr; // 前沿展开本身不拆分
+    SearchBudget unlimited;
+    unlimited.timeLimitMs = 0;
+    TourResult result;
+    if (beginSearch(prefix, unlimited)) {
+        if (depth <= 0) {
+            frontier.push_back(prefix);
+            result.stopReason = StopReason::Exhausted;
+        } else {
+            result = runSearch(std::min(m_baseDepth + depth, m_totalSteps - 1));
+        }
+    }
+    m_onTour = nullptr;
+    m_onSplit = onSplit;
+    return result;
+}
+
+// 初始化计算状态（避免残留数据影响），并校验、标记前缀
+bool KnightTourSolver::beginSearch(const std::vector<Square>& prefix, const SearchBudget& budget)
+{
+    m_begin = Clock::now();
+    m_cellCount = useBitboard() ? BITBOARD_SQUARES : m_options.width * m_options.height;
+    m_totalSteps = m_options.squareCount();
+    m_budget = budget;
+    m_budget.checkInterval = budget.checkInterval > 0 ? budget.checkInterval : DEFAULT_BUDGET_CHECK_INTERVAL;
+    m_deadline = budget.timeLimitMs > 0
+                     ? m_begin + std::chrono::milliseconds(budget.timeLimitMs)
+                     : Clock::time_point::max();
+    m_nodes = 0;
+    m_nextCheck = 0; // 第一个节点即检查一次（已取消的请求立即返回）
+    m_stopReason = StopReason::None;
+    m_tourCount = 0;
+    m_stats = SearchStats();
+    m_tableHits = 0;
+    m_tableMisses = 0;
+    m_tableStores = 0;
+    m_donatedDepth = -1;
+
+    if (prefix.empty() || static_cast<int>(prefix.size()) > m_totalSteps || !isValidPos(prefix.front())) {
+        return false;
+    }
+
+    // 搜索栈一次性分配（只增不减，重复求解时复用），搜索过程中不再分配内存
+    if (m_frames.size() < static_cast<size_t>(m_totalSteps)) {
+        m_frames.resize(m_totalSteps);
+    }
+
+    m_startPos = prefix.front();
+    m_startIndex = cellIndex(m_startPos.x, m_startPos.y);
+    buildTieRanks();
+    std::uint64_t obstacleHash = 0;
+    if (m_table) {
+        buildZobristKeys();
+        // 障碍格子与已访问格子同样计入哈希，不同障碍布局的状态互不冲突
+        if (!m_options.obstacles.empty()) {
+            for (int x = 0; x < m_options.width; x++) {
+                for (int y = 0; y < m_options.height; y++) {
+                    if (m_options.obstacles.test(indexOf(x, y))) {
+                        obstacleHash ^= m_zobrist[static_cast<size_t>(cellIndex(x, y)) * 2];
+                    }
+                }
+            }
+        }
+    }
+    if (useBitboard()) {
+        // 位棋盘快速路径：访问集合保存在一个 64 位整数中，哨兵位与障碍格子视为已访问
+        m_startBit = bitboardBit(m_startIndex);
+        m_visited8 = ~bitboardBoardMask(m_options.width, m_options.height);
+        if (!m_options.obstacles.empty()) {
+            for (int x = 0; x < m_options.width; x++) {
+                for (int y = 0; y < m_options.height; y++) {
+                    if (m_options.obstacles.test(indexOf(x, y))) {
+                        m_visited8 |= bitboardBit(bitboardIndex(x, y));
+                    }
+                }
+            }
+        }
+    } else {
+        visitLeaper(m_options.leaper, [this](auto piece) { buildNeighborTable<decltype(piece)>(); });
+    }
+
+    // 逐个标记前缀格子：必须在棋盘内、未重复且与上一格相隔一步
+    for (size_t i = 0; i < prefix.size(); i++) {
+        const Square& sq = prefix[i];
+        if (!isValidPos(sq) || m_options.obstacles.test(indexOf(sq.x, sq.y))) {
+            return false;
+        }
+        if (i > 0 && !isLeap(prefix[i - 1], sq)) {
+            return false;
+        }
+
+        const int index = cellIndex(sq.x, sq.y);
+        if (useBitboard()) {
+            if (m_visited8 & bitboardBit(index)) {
+                return false;
+            }
+            m_visited8 |= bitboardBit(index);
+        } else {
+            if (m_visited[index]) {
+                return false;
+            }
+            visit(index);
+        }
+        m_frames[i].square = index;
+        if (m_table) {
+            const std::uint64_t previous = i > 0 ? m_frames[i - 1].visitedHash
+                                                 : TranspositionTable::searchSalt(m_options.width, m_options.height,
+                                                                                  m_options.closed,
+                                                                                  indexOf(m_startPos.x, m_startPos.y),
+                                                                                  m_options.leaper)
+                                                       ^ obstacleHash;
+            m_frames[i].visitedHash = previous ^ m_zobrist[static_cast<size_t>(index) * 2];
+        }
+    }
+
+    m_baseDepth = static_cast<int>(prefix.size()) - 1;
+    if constexpr (SEARCH_STATS_ENABLED) {
+        m_stats.enabled = true;
+        m_stats.maxDepth = m_baseDepth + 1;
+        m_stats.branching.assign(m_totalSteps, {});
+    }
+    return true;
+}
+
+// 执行搜索并汇总结果
+TourResult KnightTourSolver::runSearch(int targetDepth)
+{
+    TourResult result;
+    m_targetDepth = targetDepth;
+    if (m_baseDepth == targetDepth) {
+        // 前缀本身已到达目标深度：完整路径还需检查闭合
+        bool reached = true;
+        if (targetDepth == m_totalSteps - 1 && m_options.closed) {
+            reached = isLeap(cellSquare(m_frames[targetDepth].square), m_startPos);
+        }
+        if (reached && m_onTour && !reportPath(targetDepth + 1)) {
+            m_stopReason = StopReason::Solved;
+        }
+        result.success = reached;
+    } else {
+        // 按棋子分派一次，之后整个搜索都在该棋子的实例中进行
+        result.success = visitLeaper(m_options.leaper, [this, targetDepth](auto piece) {
+            using Piece = decltype(piece);
+            return useBitboard() ? backtrack<Piece, true>(targetDepth) : backtrack<Piece, false>(targetDepth);
+        });
+    }
+
+    if (m_onTour) {
+        // 回调模式：回调要求停止时已记为 Solved，否则枚举完整结束
+        if (m_stopReason == StopReason::None) {
+            m_stopReason = StopReason::Exhausted;
+        }
+        result.success = m_tourCount > 0;
+    } else if (m_stopReason == StopReason::None) {
+        m_stopReason = result.success ? StopReason::Solved : StopReason::Exhausted;
+    }
+
+    result.stopReason = m_stopReason;
+    result.nodes = m_nodes;
+    result.tourCount = m_onTour ? m_tourCount : (result.success ? 1 : 0);
+    result.stats = m_stats;
+    if (m_table) {
+        m_table->addCounts(m_tableHits, m_tableMisses, m_tableStores);
+    }
+    if (result.success && !m_onTour) {
+        // 栈中各层的格子即为完整路径
+        result.path.reserve(targetDepth + 1);
+        for (int i = 0; i <= targetDepth; i++) {
+            result.path.push_back(cellSquare(m_frames[i].square));
+        }
+    }
+    result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_begin).count();
+    return result;
+}
+
+// 将栈中的路径交给回调（缓冲区复用）
+bool KnightTourSolver::reportPath(int length)
+{
+    m_tourCount++;
+    m_reportBuffer.clear();
+    for (int i = 0; i < length; i++) {
+        m_reportBuffer.push_back(cellSquare(m_frames[i].square));
+    }
+    return (*m_onTour)(m_reportBuffer);
+}
+
+// 预算检查（节点上限/取消/超时），每 checkInterval 个节点执行一次
+bool KnightTourSolver::checkBudget(int depth)
+{
+    // 第 maxNodes + 1 个节点不再展开，也不计入节点数：恰好需要 maxNodes 个节点的搜索仍能完成
+    if (m_budget.maxNodes > 0 && m_nodes > m_budget.maxNodes) {
+        m_nodes = m_budget.maxNodes;
+        m_stopReason = StopReason::NodeLimit;
+        return true;
+    }
+
+    if (m_budget.cancelFlag && m_budget.cancelFlag->load(std::memory_order_relaxed)) {
+        m_stopReason = StopReason::Cancelled;
+        return true;
+    }
+
+    if (Clock::now() > m_deadline) {
+        m_stopReason = StopReason::Deadline;
+        return true;
+    }
+
+    if (m_onSplit && m_splitRequested.load(std::memory_order_relaxed)) {
+        m_splitRequested.store(false, std::memory_order_relaxed);
+        donateSubtree(depth);
+    }
+
+    // 安排下一个检查点：节点上限需精确生效，不能越过
+    m_nextCheck = m_nodes + m_budget.checkInterval;
+    if (m_budget.maxNodes > 0 && m_nextCheck > m_budget.maxNodes + 1) {
+        m_nextCheck = m_budget.maxNodes + 1;
+    }
+    return false;
+}
+
+// 拆分：最浅一层的未尝试候选对应最大的子树；取其中排序最靠后（最不被看好）的一个交出，
+// 本层及以上各层的子树从此不完整，穷尽时不再记入无解状态表
+void KnightTourSolver::donateSubtree(int depth)
+{
+    for (int level = m_baseDepth; level <= depth; level++) {
+        SearchFrame& frame = m_frames[level];
+        if (frame.nextMove == frame.moveCount) {
+            continue;
+        }
+        if (m_targetDepth - (level + 1) < MIN_SPLIT_REMAINING) {
+            return;
+        }
+        std::vector<Square> subtree;
+        subtree.reserve(level + 2);
+        for (int i = 0; i <= level; i++) {
+            subtree.push_back(cellSquare(m_frames[i].square));
+        }
+        subtree.push_back(cellSquare(frame.moves[--frame.moveCount]));
+        m_donatedDepth = std::max(m_donatedDepth, level);
+        (*m_onSplit)(std::move(subtree));
+        return;
+    }
+}
+
+// 回溯算法核心（迭代实现，显式栈，每个节点零内存分配）
+template <class Piece, bool Fast8>
+bool KnightTourSolver::backtrack(int targetDepth)
+{
+    SearchFrame* const frames = m_frames.data();
+    const bool fullTour = (targetDepth == m_totalSteps - 1);
+    const int baseDepth = m_baseDepth;
+
+    // 栈的第 depth 层对应第 depth+1 步所在的格子，候选列表用于第 depth+2 步
+    int depth = baseDepth;
+    if constexpr (Fast8) {
+        expandFrame8<Piece>(frames[depth], frames[depth].square, depth + 2);
+    } else {
+        expandFrame(frames[depth], frames[depth].square, depth + 2);
+    }
+    frames[depth].forcedEnd = -1; // 前缀内部的约束未知，从本层开始推导（只会少剪，不会错剪）
+    frames[depth].toursBefore = m_tourCount;
+    const bool pruning = m_options.forwardChecking || m_options.connectivityInterval > 0;
+    // 无解状态表只用于完整路径的搜索（前沿展开的目标不是完整路径）
+    TranspositionTable* const table = fullTour ? m_table : nullptr;
+    if (shouldStop(depth)) {
+        return false;
+    }
+
+    while (depth >= baseDepth) {
+        SearchFrame& frame = frames[depth];
+
+        // 所有候选都已失败：回溯（撤销当前格子）
+        if (frame.nextMove == frame.moveCount) {
+            if (table && m_tourCount == frame.toursBefore && depth > m_donatedDepth) {
+                table->store(stateKey(frame.visitedHash, frame.square));
+                m_tableStores++;
+            }
+            if (depth == baseDepth) {
+                return false;
+            }
+            recordBacktrack(depth + 1);
+            if constexpr (Fast8) {
+                m_visited8 &= ~bitboardBit(frame.square);
+            } else {
+                unvisit(frame.square);
+            }
+            depth--;
+            continue;
+        }
+
+        // 前进：标记状态
+        const int next = frame.moves[frame.nextMove++];
+        if constexpr (Fast8) {
+            m_visited8 |= bitboardBit(next);
+        } else {
+            visit(next);
+        }
+        recordDepth(depth + 2);
+        if (shouldStop(depth)) {
+            return false;
+        }
+
+        // 剪枝：剩余格子已不可能走完时不再展开 next（完整路径不需要检查）
+        int forcedEnd = frame.forcedEnd;
+        if (pruning && depth + 2 < m_totalSteps && isDeadEnd<Piece, Fast8>(frame.square, next, depth + 2, forcedEnd)) {
+            recordPrune();
+            recordBacktrack(depth + 2);
+            if constexpr (Fast8) {
+                m_visited8 &= ~bitboardBit(next);
+            } else {
+                unvisit(next);
+            }
+            continue;
+        }
+
+        // 无解状态表：同一（已访问集合，当前格子）经其他走法顺序已证明无解时跳过
+        std::uint64_t visitedHash = 0;
+        if (table) {
+            visitedHash = frame.visitedHash ^ m_zobrist[static_cast<size_t>(next) * 2];
+            if (depth + 2 < m_totalSteps) {
+                if (table->contains(stateKey(visitedHash, next))) {
+                    m_tableHits++;
+                    recordPrune();
+                    recordBacktrack(depth + 2);
+                    if constexpr (Fast8) {
+                        m_visited8 &= ~bitboardBit(next);
+                    } else {
+                        unvisit(next);
+                    }
+                    continue;
+                }
+                m_tableMisses++;
+            }
+        }
+
+        if (depth + 1 == targetDepth) {
+            // 终止条件：完整路径需检查能否回到起点（闭合回路），前沿展开不检查
+            bool reached = true;
+            if (fullTour && m_options.closed) {
+                reached = Fast8 ? (LEAPER_ATTACKS_8<Piece>[next] & m_startBit) != 0
+                                : m_adjacentToStart[next] != 0;
+            }
+            if (reached) {
+                frames[targetDepth].square = next;
+                if (!m_onTour) {
+                    return true; // 找到第一条即返回
+                }
+                if (!reportPath(targetDepth + 1)) {
+                    m_stopReason = StopReason::Solved; // 回调要求停止
+                    return true;
+                }
+            }
+            recordBacktrack(depth + 2);
+            if constexpr (Fast8) {
+                m_visited8 &= ~bitboardBit(next);
+            } else {
+                unvisit(next);
+            }
+            continue;
+        }
+
+        depth++;
+        if constexpr (Fast8) {
+            expandFrame8<Piece>(frames[depth], next, depth + 2);
+        } else {
+            expandFrame(frames[depth], next, depth + 2);
+        }
+        frames[depth].forcedEnd = forcedEnd;
+        frames[depth].visitedHash = visitedHash;
+        frames[depth].toursBefore = m_tourCount;
+    }
+
+    return false;
+}
+
+// 前向检查（见头文件说明）与按间隔的连通性检查
+template <class Piece, bool Fast8>
+bool KnightTourSolver::isDeadEnd(int head, int next, int pathLength, int& forcedEnd)
+{
+    if (m_options.forwardChecking) {
+        // 必须作为终点的格子：与已知的终点冲突、或闭合回路时回不到起点，则无解
+        auto requireEnd = [&](int sq) {
+            if (forcedEnd >= 0 && forcedEnd != sq) {
+                return false;
+            }
+            forcedEnd = sq;
+            if constexpr (Fast8) {
+                return !m_options.closed || (LEAPER_ATTACKS_8<Piece>[sq] & m_startBit) != 0;
+            } else {
+                return !m_options.closed || m_adjacentToStart[sq] != 0;
+            }
+        };
+
+        if constexpr (Fast8) {
+            const Bitboard unvisited = ~m_visited8;
+            if (forcedEnd >= 0 && (m_visited8 & bitboardBit(forcedEnd))) {
+                forcedEnd = -1;
+            }
+            if (m_options.closed) {
+                // 最后一格要回到起点：起点须留有未访问的邻居，只剩一个时它就是终点
+                const Bitboard startLinks = LEAPER_ATTACKS_8<Piece>[m_startIndex] & unvisited;
+                if (startLinks == 0 || ((startLinks & (startLinks - 1)) == 0
+                                        && !requireEnd(lowestBitIndex(startLinks)))) {
+                    return true;
+                }
+            }
+            Bitboard affected = LEAPER_ATTACKS_8<Piece>[head] & unvisited;
+            while (affected != 0) {
+                const int sq = lowestBitIndex(affected);
+                affected &= affected - 1;
+                const Bitboard edges = LEAPER_ATTACKS_8<Piece>[sq] & (unvisited | bitboardBit(next));
+                if (edges == 0 || ((edges & (edges - 1)) == 0 && !requireEnd(sq))) {
+                    return true;
+                }
+            }
+        } else {
+            if (forcedEnd >= 0 && m_visited[forcedEnd]) {
+                forcedEnd = -1;
+            }
+            if (m_options.closed) {
+                const int startLinks = m_degree[m_startIndex];
+                if (startLinks == 0) {
+                    return true;
+                }
+                if (startLinks == 1) {
+                    const int* neighbors = &m_neighbors[static_cast<size_t>(m_startIndex) * MOVE_COUNT];
+                    for (int i = 0; i < m_neighborCount[m_startIndex]; i++) {
+                        if (!m_visited[neighbors[i]] && !requireEnd(neighbors[i])) {
+                            return true;
+                        }
+                    }
+                }
+            }
+            const int* neighbors = &m_neighbors[static_cast<size_t>(head) * MOVE_COUNT];
+            for (int i = 0; i < m_neighborCount[head]; i++) {
+                const int sq = neighbors[i];
+                if (m_visited[sq] || m_degree[sq] > 1) {
+                    continue;
+                }
+                // 度数不超过 1 时才需要确认是否与新端点相邻
+                int edges = m_degree[sq];
+                const int* links = &m_neighbors[static_cast<size_t>(sq) * MOVE_COUNT];
+                edges += std::find(links, links + m_neighborCount[sq], next) != links + m_neighborCount[sq];
+                if (edges == 0 || (edges == 1 && !requireEnd(sq))) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    if (m_options.connectivityInterval > 0 && pathLength % m_options.connectivityInterval == 0) {
+        if constexpr (Fast8) {
+            return isDisconnected8<Piece>(next);
+        } else {
+            return isDisconnected(next);
+        }
+    }
+    return false;
+}
+
+// Zobrist 键由格子下标确定，所有求解器一致（共享无解状态表的前提）
+void KnightTourSolver::buildZobristKeys()
+{
+    const size_t count = static_cast<size_t>(m_cellCount) * 2;
+    if (m_zobrist.size() == count) {
+        return;
+    }
+    m_zobrist.resize(count);
+    for (int i = 0; i < m_cellCount; i++) {
+        m_zobrist[static_cast<size_t>(i) * 2] = TranspositionTable::zobristKey(i, 0);
+        m_zobrist[static_cast<size_t>(i) * 2 + 1] = TranspositionTable::zobristKey(i, 1);
+    }
+}
+
+// 连通性检查（通用路径）：显式栈洪泛，到达标记按轮次区分，不必清零
+bool KnightTourSolver::isDisconnected(int next)
+{
+    if (++m_floodStamp == 0) {
+        std::fill(m_floodMark.begin(), m_floodMark.end(), 0u);
+        m_floodStamp = 1;
+    }
+    int reached = 0;
+    m_floodStack.clear();
+    m_floodStack.push_back(next);
+    while (!m_floodStack.empty()) {
+        const int sq = m_floodStack.back();
+        m_floodStack.pop_back();
+        const int* neighbors = &m_neighbors[static_cast<size_t>(sq) * MOVE_COUNT];
+        for (int i = 0; i < m_neighborCount[sq]; i++) {
+            const int neighbor = neighbors[i];
+            if (!m_visited[neighbor] && m_floodMark[neighbor] != m_floodStamp) {
+                m_floodMark[neighbor] = m_floodStamp;
+                m_floodStack.push_back(neighbor);
+                reached++;
+            }
+        }
+    }
+    return reached < m_unvisitedCount;
+}
+
+// 连通性检查（8x8 快速路径）：整个集合按方向移位扩展，直到不再增长
+template <class Piece>
+bool KnightTourSolver::isDisconnected8(int next) const
+{
+    const Bitboard unvisited = ~m_visited8;
+    Bitboard reached = LEAPER_ATTACKS_8<Piece>[next] & unvisited;
+    for (;;) {
+        const Bitboard grown = reached | (leaperSpread8<Piece>(reached) & unvisited);
+        if (grown == reached) {
+            break;
+        }
+        reached = grown;
+    }
+    return (unvisited & ~reached) != 0;
+}
+
+// 展开栈帧（通用路径）：生成并排序当前格子的候选移动
+void KnightTourSolver::expandFrame(SearchFrame& frame, int index, int step)
+{
+    frame.square = index;
+    frame.nextMove = 0;
+    const Clock::time_point begin = statsNow();
+    frame.moveCount = getValidMoves(index, frame.moves);
+    const Clock::time_point generated = statsNow();
+    sortMovesByWarnsdorff(frame.moves, frame.moveCount, step);
+    recordExpansion(step - 1, frame.moveCount, begin, generated);
+}
+
+// 展开栈帧（8x8 快速路径）
+template <class Piece>
+void KnightTourSolver::expandFrame8(SearchFrame& frame, int sq, int step)
+{
+    frame.square = sq;
+    frame.nextMove = 0;
+    const Clock::time_point begin = statsNow();
+
+    // 展开候选格子（位序即坐标序号，排序键使用辅助排序序号）
+    Bitboard candidates = LEAPER_ATTACKS_8<Piece>[sq] & ~m_visited8;
+    int moveCount = 0;
+    while (candidates != 0) {
+        frame.moves[moveCount++] = lowestBitIndex(candidates);
+        candidates &= candidates - 1;
+    }
+    frame.moveCount = moveCount;
+    const Clock::time_point generated = statsNow();
+
+    // 按优先级排序：1. 是否能返回起点（最后一步） 2. 后续有效移动数 3. 坐标序号
+    const bool isFinalStep = m_options.closed && (step == m_totalSteps);
+    const Bitboard unvisited = ~m_visited8;
+    MoveKey keys[MOVE_COUNT];
+    for (int i = 0; i < moveCount; i++) {
+        const Bitboard attacks = LEAPER_ATTACKS_8<Piece>[frame.moves[i]];
+        const bool cannotReturn = isFinalStep && (attacks & m_startBit) == 0;
+        keys[i] = makeMoveKey(cannotReturn, popCount(attacks & unvisited), m_tieRank[frame.moves[i]]);
+    }
+    sortMovesByKey(frame.moves, keys, moveCount);
+    recordExpansion(step - 1, moveCount, begin, generated);
+}
+
+// 构建邻接表与初始度数（每个格子只做一次边界检查）
+// 障碍格子标记为已访问且没有邻居，也不出现在其他格子的邻接表中，搜索过程中永远不会被访问或撤销
+template <class Piece>
+void KnightTourSolver::buildNeighborTable()
+{
+    const ObstacleMask& obstacles = m_options.obstacles;
+    m_visited.assign(m_cellCount, 0);
+    m_neighbors.assign(static_cast<size_t>(m_cellCount) * MOVE_COUNT, 0);
+    m_neighborCount.assign(m_cellCount, 0);
+    m_degree.assign(m_cellCount, 0);
+    m_adjacentToStart.assign(m_cellCount, 0);
+    m_floodMark.assign(m_cellCount, 0u);
+    m_floodStamp = 0;
+    m_floodStack.reserve(m_totalSteps);
+    m_unvisitedCount = m_totalSteps;
+
+    const int startIndex = indexOf(m_startPos.x, m_startPos.y);
+    for (int x = 0; x < m_options.width; x++) {
+        for (int y = 0; y < m_options.height; y++) {
+            const int index = indexOf(x, y);
+            if (obstacles.test(index)) {
+                m_visited[index] = 1;
+                continue;
+            }
+            int count = 0;
+            forEachLeap<Piece>([&](auto i) {
+                constexpr MoveDelta dir = Piece::directions[decltype(i)::value];
+                const int nx = x + dir.dx;
+                const int ny = y + dir.dy;
+                if (inBoard(nx, ny) && !obstacles.test(indexOf(nx, ny))) {
+                    const int neighbor = indexOf(nx, ny);
+                    m_neighbors[static_cast<size_t>(index) * MOVE_COUNT + count++] = neighbor;
+                    if (neighbor == startIndex) {
+                        m_adjacentToStart[index] = 1;
+                    }
+                }
+            });
+            m_neighborCount[index] = static_cast<unsigned char>(count);
+            m_degree[index] = count;
+        }
+    }
+}
+
+// 构建辅助排序序号表（不同种子给出不同的同度数选择顺序）
+// 序号按坐标序（indexOf）生成；位棋盘路径再按位序重新存放，两条路径的同度数选择顺序一致
+void KnightTourSolver::buildTieRanks()
+{
+    const int squares = m_options.width * m_options.height;
+    m_tieRank.resize(squares);
+    std::iota(m_tieRank.begin(), m_tieRank.end(), 0);
+    if (m_options.tieBreakSeed != 0) {
+        std::mt19937 rng(m_options.tieBreakSeed);
+        std::shuffle(m_tieRank.begin(), m_tieRank.end(), rng);
+    }
+    if (useBitboard() && m_options.height != BITBOARD_SIZE) {
+        // 位序不小于坐标序，从后往前搬移不会覆盖尚未读取的序号（哨兵位上的值不会被使用）
+        m_tieRank.resize(BITBOARD_SQUARES);
+        for (int index = squares - 1; index >= 0; index--) {
+            const Square sq = squareOf(index);
+            m_tieRank[bitboardIndex(sq.x, sq.y)] = m_tieRank[index];
+        }
+    }
+}
+
+// 访问格子（增量更新邻居度数）
+void KnightTourSolver::visit(int index)
+{
+    m_visited[index] = 1;
+    m_unvisitedCount--;
+    const int* neighbors = &m_neighbors[static_cast<size_t>(index) * MOVE_COUNT];
+    for (int i = 0; i < m_neighborCount[index]; i++) {
+        m_degree[neighbors[i]]--;
+    }
+}
+
+// 撤销访问（恢复邻居度数）
+void KnightTourSolver::unvisit(int index)
+{
+    m_visited[index] = 0;
+    m_unvisitedCount++;
+    const int* neighbors = &m_neighbors[static_cast<size_t>(index) * MOVE_COUNT];
+    for (int i = 0; i < m_neighborCount[index]; i++) {
+        m_degree[neighbors[i]]++;
+    }
+}
+
+// 获取有效移动（遍历预先计算的邻居，无边界检查）
+int KnightTourSolver::getValidMoves(int index, int* moves) const
+{
+    const int* neighbors = &m_neighbors[static_cast<size_t>(index) * MOVE_COUNT];
+    int count = 0;
+    for (int i = 0; i < m_neighborCount[index]; i++) {
+        if (!m_visited[neighbors[i]]) {
+            moves[count++] = neighbors[i];
+        }
+    }
+    return count;
+}
+
+// Warnsdorff规则排序（排序键一次算好，比较器不再重复计数）
+void KnightTourSolver::sortMovesByWarnsdorff(int* moves, int count, int step) const
+{
+    const bool isFinalStep = m_options.closed && (step == m_totalSteps);
+
+    // 按优先级排序：1. 是否能返回起点（最后一步） 2. 后续有效移动数 3. 坐标序号
+    MoveKey keys[MOVE_COUNT];
+    for (int i = 0; i < count; i++) {
+        const bool cannotReturn = isFinalStep && !m_adjacentToStart[moves[i]];
+        keys[i] = makeMoveKey(cannotReturn, m_degree[moves[i]], m_tieRank[moves[i]]);
+    }
+    sortMovesByKey(moves, keys, count);
+}
@@ -0,0 +1,427 @@
+#ifndef KNIGHTTOURSOLVER_H
+#define KNIGHTTOURSOLVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "bitboard8.h"
+#include "moveordering.h"
+#include "tourcache.h"
+#include "tourtypes.h"
+#include "transpositiontable.h"
+
+/**
+ * @brief 路径回调：找到一条满足条件的路径时调用
+ * @param path 完整路径（起点在首位），仅在回调期间有效
+ * @return true=继续搜索，false=停止搜索
+ */
+using TourCallback = std::function<bool(const std::vector<Square>& path)>;
+
+/**
+ * @brief 子树拆分回调：交出一棵尚未搜索的子树（以完整的路径前缀表示）
+ */
+using SplitCallback = std::function<void(std::vector<Square>&& subtree)>;
+
+/**
+ * @brief 骑士巡游求解器（无界面）
+ * 实现基于 Warnsdorff 算法+回溯法的骑士巡游（哈密顿回路），
+ * 不依赖 QWidget/QtGui，可在批量任务或性能分析中直接使用
+ * 宽、高都不超过 8 的棋盘（5x5~8x8 以及 5x6、6x7 等矩形）使用位棋盘快速路径（64 位访问集合 + 编译期攻击表），
+ * 棋盘嵌入 8x8 位棋盘，多出的位作为边界哨兵一开始就标记为已访问；
+ * 更大的棋盘使用通用路径（预先计算的邻接表，同样没有边界检查）
+ * 棋子由 TourOptions::leaper 指定（马、骆驼、斑马、长颈鹿），每次搜索开始时分派一次，
+ * 热路径按编译期跳子（leaper.h）实例化，各棋子的走法表与攻击表都是常量
+ * 障碍格子（TourOptions::obstacles）在两条路径中都视为一开始就已访问，路径只需走遍其余格子
+ */
+class KnightTourSolver
+{
+public:
+    explicit KnightTourSolver(const TourOptions& options = TourOptions());
+
+    /**
+     * @brief 获取当前求解选项
+     */
+    const TourOptions& options() const { return m_options; }
+
+    /**
+     * @brief 修改求解选项（下一次 solve 生效）
+     */
+    void setOptions(const TourOptions& options);
+
+    /**
+     * @brief 设置闭合回路缓存（不持有，可为空）
+     * 设置后 solve 先查询缓存，命中时直接旋转缓存的回路而不搜索；未命中时搜索并保存结果
+     */
+    void setTourCache(TourCache* cache) { m_tourCache = cache; }
+    TourCache* tourCache() const { return m_tourCache; }
+
+    /**
+     * @brief 设置无解状态表（不持有，可为空；可在多个求解器之间共享）
+     * 设置后搜索完整路径时跳过表中已证明无解的状态，并记录新穷尽的状态；
+     * 命中/未命中次数在每次搜索结束时累加到表中
+     */
+    void setTranspositionTable(TranspositionTable* table) { m_table = table; }
+    TranspositionTable* transpositionTable() const { return m_table; }
+
+    /**
+     * @brief 从指定起点求解骑士巡游（闭合回路优先查询缓存）
+     * 搜索前先做快速预检查（checkTourFeasibility），不可能有解时立即以 Exhausted 返回
+     * @param start 起始位置（0-based）
+     * @param budget 搜索预算（超时、节点上限、取消标志）
+     * @return 求解结果（路径、终止原因、节点数、耗时）
+     */
+    TourResult solve(const Square& start, const SearchBudget& budget = SearchBudget());
+
+    /**
+     * @brief 从给定的路径前缀继续求解（前缀中的格子视为已走过，不会回溯到前缀内部）
+     * @param prefix 路径前缀（首个格子为起点，相邻格子须为马步且不重复）
+     * @param budget 搜索预算
+     * @return 求解结果；前缀无效时 stopReason 为 None
+     */
+    TourResult solveFrom(const std::vector<Square>& prefix, const SearchBudget& budget = SearchBudget());
+
+    /**
+     * @brief 枚举给定前缀下的所有路径，每找到一条调用一次 onTour
+     * @param prefix 路径前缀
+     * @param onTour 路径回调（返回 false 时停止枚举）
+     * @param budget 搜索预算
+     * @return 枚举结果：tourCount 为找到的路径数；完整枚举时 stopReason 为 Exhausted，
+     *         回调要求停止时为 Solved
+     */
+    TourResult enumerateFrom(const std::vector<Square>& prefix, const TourCallback& onTour,
+                             const SearchBudget& budget = SearchBudget());
+
+    /**
+     * @brief 按 Warnsdorff 顺序展开搜索树的前沿（用于并行划分子树）
+     * @param prefix 路径前缀
+     * @param depth 在前缀基础上再展开的步数
+     * @param frontier 输出：长度为 prefix.size() + depth 的全部可行前缀（按搜索顺序排列），
+     *                 前沿超过棋盘格子数时为完整路径
+     * @return 展开的搜索结果：nodes 为展开时搜索的节点数；前缀无效时 stopReason 为 None
+     */
+    TourResult expandFrontier(const std::vector<Square>& prefix, int depth,
+                              std::vector<std::vector<Square>>& frontier);
+
+    /**
+     * @brief 设置子树拆分回调（不持有，可为空）
+     * 搜索被请求拆分时（见 requestSplit），把最浅一层尚未尝试的最后一个候选作为子树交给回调，
+     * 本求解器不再搜索该子树；剩余步数太少的子树不拆分
+     */
+    void setSplitCallback(const SplitCallback* onSplit) { m_onSplit = onSplit; }
+
+    /**
+     * @brief 请求拆分正在进行的搜索（可从其他线程调用，在下一个预算检查点处理；没有拆分回调时忽略）
+     */
+    void requestSplit() { m_splitRequested.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief 检查坐标是否有效（在棋盘内）
+     */
+    bool isValidPos(const Square& pos) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 搜索栈帧：一层对应路径上的一个格子
+     * 保存该格子已排序的候选移动及下一个待尝试的候选下标
+     */
+    struct SearchFrame
+    {
+        int square = 0;                // 当前格子（一维下标）
+        int moveCount = 0;             // 候选数量
+        int nextMove = 0;              // 下一个待尝试的候选下标
+        int forcedEnd = -1;            // 只剩一条可用边、必须作为路径终点的未访问格子（-1 表示没有）
+        std::uint64_t visitedHash = 0; // 到本层为止已访问集合的 Zobrist 哈希（仅使用无解状态表时维护）
+        long long toursBefore = 0;     // 进入本层时已找到的路径数（子树没有新路径才记为无解）
+        int moves[MOVE_COUNT] = {};    // 已排序的候选格子
+    };
+
+    /**
+     * @brief 初始化一次搜索：预算、搜索栈、邻接表，并标记前缀中的格子
+     * @return 前缀是否有效
+     */
+    bool beginSearch(const std::vector<Square>& prefix, const SearchBudget& budget);
+
+    /**
+     * @brief 执行搜索并汇总结果（路径、终止原因、节点数、耗时）
+     * @param targetDepth 目标深度（栈层下标），m_totalSteps-1 表示完整路径
+     */
+    TourResult runSearch(int targetDepth);
+
+    /**
+     * @brief 回溯算法核心（迭代实现）
+     * 使用预分配的显式栈代替递归，每个节点零内存分配，
+     * 大棋盘（深度 N²）也不会耗尽线程栈
+     * Fast8=true 时为位棋盘快速路径：走法生成为 attacks[sq] & ~visited（哨兵位恒为已访问），
+     * Warnsdorff 度数为 popcount，搜索顺序与通用路径完全一致
+     * Piece 为编译期跳子（决定攻击表与闭合判定）
+     * @param targetDepth 到达即视为找到路径的栈层
+     * @return 是否找到路径（未设置回调时路径保存在 m_frames 中）
+     */
+    template <class Piece, bool Fast8>
+    bool backtrack(int targetDepth);
+
+    /**
+     * @brief 展开栈帧：生成当前格子的有效移动并按 Warnsdorff 规则排序
+     * @param frame 待填充的栈帧
+     * @param index 当前格子
+     * @param step 候选移动对应的步骤数（用于最后一步特殊处理）
+     */
+    void expandFrame(SearchFrame& frame, int index, int step);
+    template <class Piece>
+    void expandFrame8(SearchFrame& frame, int sq, int step);
+
+    /**
+     * @brief 前向检查：路径从 head 走到 next（已标记访问）之后，剩余格子是否已不可能走完
+     * 只有 head 的未访问邻居失去了一条可用边（head 不再是路径端点），因此只需检查它们：
+     * 可用边 = 剩余度数 + 是否与新端点 next 相邻；为 0 则不可达，为 1 则必须是终点，
+     * 终点至多一个，闭合回路时终点还须与起点相邻，且起点必须留有未访问的邻居
+     * @param forcedEnd 输入上一层的必经终点，输出本层的必经终点
+     * @param pathLength 走到 next 后的路径长度（用于按间隔做连通性检查）
+     */
+    template <class Piece, bool Fast8>
+    bool isDeadEnd(int head, int next, int pathLength, int& forcedEnd);
+
+    /**
+     * @brief 无解状态表的键：已访问集合的哈希与当前格子
+     */
+    std::uint64_t stateKey(std::uint64_t visitedHash, int square) const
+    {
+        return visitedHash ^ m_zobrist[static_cast<size_t>(square) * 2 + 1];
+    }
+
+    /**
+     * @brief 准备 Zobrist 键表（格子数变化时重建）
+     */
+    void buildZobristKeys();
+
+    /**
+     * @brief 连通性检查：从 next 出发经未访问格子洪泛，是否有到不了的格子
+     */
+    bool isDisconnected(int next);
+    template <class Piece>
+    bool isDisconnected8(int next) const;
+
+    /**
+     * @brief 统计计时：SEARCH_STATS_ENABLED 为 false 时不读时钟
+     */
+    static Clock::time_point statsNow()
+    {
+        if constexpr (SEARCH_STATS_ENABLED) {
+            return Clock::now();
+        } else {
+            return Clock::time_point();
+        }
+    }
+
+    /**
+     * @brief 记录一次栈帧展开：候选数直方图与走法生成/排序耗时
+     * @param pathLength 被展开格子所在的路径长度
+     * @param begin 走法生成开始时间
+     * @param generated 走法生成结束（排序开始）时间
+     */
+    void recordExpansion(int pathLength, int moveCount, Clock::time_point begin, Clock::time_point generated)
+    {
+        if constexpr (SEARCH_STATS_ENABLED) {
+            const Clock::time_point sorted = Clock::now();
+            m_stats.branching[pathLength - 1][moveCount]++;
+            m_stats.moveGenNs += std::chrono::duration_cast<std::chrono::nanoseconds>(generated - begin).count();
+            m_stats.orderingNs += std::chrono::duration_cast<std::chrono::nanoseconds>(sorted - generated).count();
+        }
+    }
+
+    /**
+     * @brief 记录一次回溯（撤销路径长度为 pathLength 的最后一格）
+     */
+    void recordBacktrack(int pathLength)
+    {
+        if constexpr (SEARCH_STATS_ENABLED) {
+            m_stats.backtracks++;
+            if (m_stats.firstBacktrackDepth < 0) {
+                m_stats.firstBacktrackDepth = pathLength;
+            }
+        }
+    }
+
+    /**
+     * @brief 记录一次剪枝
+     */
+    void recordPrune()
+    {
+        if constexpr (SEARCH_STATS_ENABLED) {
+            m_stats.prunes++;
+        }
+    }
+
+    /**
+     * @brief 记录到达的路径长度
+     */
+    void recordDepth(int pathLength)
+    {
+        if constexpr (SEARCH_STATS_ENABLED) {
+            m_stats.maxDepth = std::max(m_stats.maxDepth, pathLength);
+        }
+    }
+
+    /**
+     * @brief 将栈中前 length 层的格子交给回调
+     * @return 回调是否要求继续搜索
+     */
+    bool reportPath(int length);
+
+    /**
+     * @brief 检查是否应终止搜索（每个节点调用一次）
+     * 热路径只做一次计数比较，到达检查点时才调用 checkBudget
+     * @param depth 当前栈顶所在的层（拆分时只考虑栈中的各层）
+     */
+    bool shouldStop(int depth)
+    {
+        return ++m_nodes >= m_nextCheck && checkBudget(depth);
+    }
+
+    /**
+     * @brief 检查节点上限、取消标志与超时，结果记录到 m_stopReason，并安排下一个检查点；
+     * 同时处理拆分请求
+     */
+    bool checkBudget(int depth);
+
+    /**
+     * @brief 拆分当前搜索：交出栈中最浅一层尚未尝试的最后一个候选（见 setSplitCallback）
+     * @param depth 当前栈顶所在的层
+     */
+    void donateSubtree(int depth);
+
+    /**
+     * @brief 构建邻接表与初始度数（通用路径，每次 solve 调用一次）
+     * 之后的走法生成只遍历预先计算的邻居，不再做边界检查；
+     * 走法方向来自编译期跳子，逐格的方向循环完全展开
+     */
+    template <class Piece>
+    void buildNeighborTable();
+
+    /**
+     * @brief 构建辅助排序序号表（tieBreakSeed=0 时为坐标序号，否则为按种子打乱的排列）
+     */
+    void buildTieRanks();
+
+    /**
+     * @brief 获取当前位置的所有有效移动
+     * 筛选未访问的邻居格子
+     * @param index 当前位置（一维下标）
+     * @param moves 输出：有效移动目标格子（容量至少 MOVE_COUNT）
+     * @return 有效移动数量
+     */
+    int getValidMoves(int index, int* moves) const;
+
+    /**
+     * @brief 两个格子之间是否为当前棋子的一步（前缀校验与闭合判定）
+     */
+    bool isLeap(const Square& from, const Square& to) const
+    {
+        return isLeaperMove(m_options.leaper, to.x - from.x, to.y - from.y);
+    }
+
+    /**
+     * @brief 按 Warnsdorff 规则排序有效移动
+     * 度数直接读取增量维护的 m_degree，排序键只计算一次
+     * @param moves 待排序的有效移动列表
+     * @param count 有效移动数量
+     * @param step 当前步骤数（用于最后一步特殊处理）
+     */
+    void sortMovesByWarnsdorff(int* moves, int count, int step) const;
+
+    /**
+     * @brief 访问格子：标记访问并将所有邻居的剩余度数减一（O(8)）
+     */
+    void visit(int index);
+
+    /**
+     * @brief 撤销访问：清除访问标记并恢复邻居的剩余度数（O(8)）
+     */
+    void unvisit(int index);
+
+    /**
+     * @brief 是否使用位棋盘快速路径（宽、高都不超过 8，且 options.bitboard 未关闭）
+     */
+    bool useBitboard() const
+    {
+        return m_options.bitboard && m_options.width <= BITBOARD_SIZE && m_options.height <= BITBOARD_SIZE;
+    }
+
+    /**
+     * @brief 坐标转一维下标（x * height + y，与原排序序号一致；障碍掩码按此下标存储）
+     */
+    int indexOf(int x, int y) const { return x * m_options.height + y; }
+
+    Square squareOf(int index) const { return Square(index / m_options.height, index % m_options.height); }
+
+    /**
+     * @brief 坐标转搜索使用的格子编号（位棋盘路径为位序 x * 8 + y，通用路径为 indexOf；8x8 时两者相同）
+     * 搜索栈、排序序号与 Zobrist 键都按格子编号存储，只在搜索开始与输出路径时转换
+     */
+    int cellIndex(int x, int y) const { return useBitboard() ? bitboardIndex(x, y) : indexOf(x, y); }
+
+    Square cellSquare(int cell) const
+    {
+        return useBitboard() ? Square(cell / BITBOARD_SIZE, cell % BITBOARD_SIZE) : squareOf(cell);
+    }
+
+    bool inBoard(int x, int y) const
+    {
+        return x >= 0 && x < m_options.width && y >= 0 && y < m_options.height;
+    }
+
+    // -------------------------- 成员变量 --------------------------
+    TourOptions m_options;
+    TourCache* m_tourCache = nullptr;  // 闭合回路缓存（不持有）
+    TranspositionTable* m_table = nullptr; // 无解状态表（不持有）
+    std::vector<std::uint64_t> m_zobrist;  // Zobrist 键：第 i 个格子的 [已访问, 当前所在] 两个键
+    long long m_tableHits = 0;         // 本次搜索的无解状态表命中/未命中/写入次数
+    long long m_tableMisses = 0;
+    long long m_tableStores = 0;
+    std::vector<char> m_visited;       // 访问标记（按 indexOf 存储）
+    std::vector<int> m_neighbors;      // 邻接表：第 i 个格子的邻居位于 [i * MOVE_COUNT, i * MOVE_COUNT + m_neighborCount[i])
+    std::vector<unsigned char> m_neighborCount; // 每个格子的邻居数量
+    std::vector<int> m_degree;         // 每个格子剩余的未访问邻居数（Warnsdorff 度数，增量维护）
+    std::vector<char> m_adjacentToStart; // 是否与起点相邻（能否返回起点）
+    std::vector<int> m_tieRank;        // 同度数候选的辅助排序序号（按一维下标存储）
+    std::vector<SearchFrame> m_frames; // 搜索栈（预分配，第 i 层为第 i+1 步的格子）
+    Square m_startPos;                 // 起始位置
+    int m_startIndex = 0;              // 起始位置（格子编号）
+    std::vector<int> m_floodStack;     // 连通性检查的待扩展格子（复用）
+    std::vector<unsigned> m_floodMark; // 连通性检查的到达标记（与 m_floodStamp 相等即已到达，不必每次清零）
+    unsigned m_floodStamp = 0;
+    int m_unvisitedCount = 0;          // 未访问的格子数（通用路径，随 visit/unvisit 维护）
+    int m_cellCount = 0;               // 格子编号的范围（含障碍格子与哨兵位，按格子编号存储的数组均为此长度）
+    int m_totalSteps = 0;              // 完整路径的长度（不含障碍格子）
+    int m_baseDepth = 0;               // 前缀末端所在的栈层（搜索不会回溯到更浅的层）
+    SearchBudget m_budget;             // 本次求解的搜索预算
+    Clock::time_point m_begin;         // 本次求解开始时间
+    Clock::time_point m_deadline;      // 超时时间点
+    long long m_nodes = 0;             // 已搜索节点数
+    long long m_nextCheck = 0;         // 下一个预算检查点（节点数）
+    StopReason m_stopReason = StopReason::None; // 终止原因
+    SearchStats m_stats;               // 搜索统计（仅 SEARCH_STATS_ENABLED 时收集）
+
+    // 子树拆分状态
+    static constexpr int MIN_SPLIT_REMAINING = 16; // 交出的子树至少还剩这么多步，过小的子树不值得重新初始化
+    const SplitCallback* m_onSplit = nullptr;  // 拆分回调，为空表示不拆分
+    std::atomic<bool> m_splitRequested{false}; // 其他线程请求拆分
+    int m_donatedDepth = -1;                   // 交出过候选的最深栈层（该层及以上的子树不完整，不能记为无解）
+    int m_targetDepth = 0;                     // 本次搜索的目标栈层
+
+    // 回调模式（枚举/前沿展开）状态
+    const TourCallback* m_onTour = nullptr; // 路径回调，为空表示找到第一条即返回
+    std::vector<Square> m_reportBuffer;     // 回调使用的路径缓冲（复用，避免每次分配）
+    long long m_tourCount = 0;              // 已找到的路径数
+
+    // 位棋盘快速路径状态
+    Bitboard m_visited8 = 0;           // 访问集合（位棋盘，含哨兵位）
+    Bitboard m_startBit = 0;           // 起点所在位
+};
+
+#endif // KNIGHTTOURSOLVER_H
@@ -0,0 +1,114 @@
+#ifndef LEAPER_H
+#define LEAPER_H
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "tourtypes.h"
+
+/**
+ * @brief (a, b) 跳子的 8 个走法方向，顺序与 MOVE_DIRECTIONS 对应（(1, 2) 即为马）
+ */
+constexpr std::array<MoveDelta, MOVE_COUNT> makeLeaperDirections(int a, int b)
+{
+    return {{{b, a}, {a, b}, {-a, b}, {-b, a}, {-b, -a}, {-a, -b}, {a, -b}, {b, -a}}};
+}
+
+/**
+ * @brief 编译期跳子：每步沿一个轴走 A 格、另一个轴走 B 格（0 < A < B 时恰好 8 个方向）
+ * 走法表、可达距离与是否变色都是编译期常量，求解器按跳子实例化热路径，
+ * 每种棋子得到自己的走法生成代码，运行期没有额外的分支或查表
+ */
+template <int A, int B>
+struct Leaper
+{
+    static_assert(0 < A && A < B, "跳子的两个步长须满足 0 < A < B");
+
+    static constexpr int shortStep = A;
+    static constexpr int longStep = B;
+    static constexpr std::array<MoveDelta, MOVE_COUNT> directions = makeLeaperDirections(A, B);
+    static constexpr int reach = B;                        // 一步在单个轴上的最大距离（填充宽度）
+    static constexpr bool changesColor = ((A + B) & 1) != 0; // 每步是否改变格子颜色
+
+    static constexpr bool isMove(int dx, int dy)
+    {
+        dx = dx < 0 ? -dx : dx;
+        dy = dy < 0 ? -dy : dy;
+        return (dx == A && dy == B) || (dx == B && dy == A);
+    }
+};
+
+using KnightLeaper = Leaper<1, 2>;   // 马
+using CamelLeaper = Leaper<1, 3>;    // 骆驼（不变色，只能走遍同色格子）
+using ZebraLeaper = Leaper<2, 3>;    // 斑马
+using GiraffeLeaper = Leaper<1, 4>;  // 长颈鹿
+
+static_assert(KnightLeaper::directions[0].dx == MOVE_DIRECTIONS[0].dx
+                  && KnightLeaper::directions[7].dy == MOVE_DIRECTIONS[7].dy,
+              "马的走法顺序与 MOVE_DIRECTIONS 一致（Warnsdorff 的同度数顺序不变）");
+static_assert(!CamelLeaper::changesColor && ZebraLeaper::changesColor, "a + b 为偶数的跳子不变色");
+
+/**
+ * @brief 按走法方向依次调用 f(std::integral_constant<int, i>)，循环在编译期完全展开，
+ * 方向 i 的位移可在 f 中作为常量读取：Piece::directions[decltype(i)::value]
+ */
+template <class Piece, class F, std::size_t... I>
+constexpr void forEachLeapIndexed(F&& f, std::index_sequence<I...>)
+{
+    (f(std::integral_constant<int, static_cast<int>(I)>()), ...);
+}
+
+template <class Piece, class F>
+constexpr void forEachLeap(F&& f)
+{
+    forEachLeapIndexed<Piece>(std::forward<F>(f), std::make_index_sequence<MOVE_COUNT>());
+}
+
+/**
+ * @brief 按运行期的跳子类型分派到编译期跳子：以对应 Leaper 的对象调用 visitor，返回其结果
+ */
+template <class Visitor>
+decltype(auto) visitLeaper(LeaperType type, Visitor&& visitor)
+{
+    switch (type) {
+    case LeaperType::Camel:   return visitor(CamelLeaper());
+    case LeaperType::Zebra:   return visitor(ZebraLeaper());
+    case LeaperType::Giraffe: return visitor(GiraffeLeaper());
+    case LeaperType::Knight:  break;
+    }
+    return visitor(KnightLeaper());
+}
+
+/**
+ * @brief 跳子的走法方向表（运行期查询）
+ */
+inline const std::array<MoveDelta, MOVE_COUNT>& leaperDirections(LeaperType type)
+{
+    switch (type) {
+    case LeaperType::Camel:   return CamelLeaper::directions;
+    case LeaperType::Zebra:   return ZebraLeaper::directions;
+    case LeaperType::Giraffe: return GiraffeLeaper::directions;
+    case LeaperType::Knight:  break;
+    }
+    return KnightLeaper::directions;
+}
+
+/**
+ * @brief (dx, dy) 是否为该跳子的一步
+ */
+inline bool isLeaperMove(LeaperType type, int dx, int dy)
+{
+    return visitLeaper(type, [dx, dy](auto piece) { return decltype(piece)::isMove(dx, dy); });
+}
+
+/**
+ * @brief 跳子一步在单个轴上的最大距离
+ */
+inline int leaperReach(LeaperType type)
+{
+    return visitLeaper(type, [](auto piece) { return decltype(piece)::reach; });
+}
+
+#endif // LEAPER_H
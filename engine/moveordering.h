@@ -0,0 +1,44 @@
+#ifndef MOVEORDERING_H
+#define MOVEORDERING_H
+
+#include <cstdint>
+
+#include "tourtypes.h"
+
+// Warnsdorff 排序键（越小越优先）：
+//   第 40 位：最后一步不能返回起点（闭合回路时）
+//   第 32~39 位：后续有效移动数（度数）
+//   低 32 位：辅助排序序号（默认为坐标序号，可按种子打乱，保证结果确定）
+using MoveKey = std::uint64_t;
+
+constexpr MoveKey makeMoveKey(bool cannotReturn, int degree, int tieRank)
+{
+    return (MoveKey(cannotReturn ? 1 : 0) << 40)
+           | (MoveKey(static_cast<unsigned>(degree)) << 32)
+           | MoveKey(static_cast<std::uint32_t>(tieRank));
+}
+
+/**
+ * @brief 按预先计算的键对候选移动排序（插入排序，候选数不超过 MOVE_COUNT）
+ * 比较只涉及整数键，不再在比较器中重复计算度数
+ * @param moves 候选格子（一维下标）
+ * @param keys 与 moves 一一对应的排序键
+ * @param count 候选数量
+ */
+inline void sortMovesByKey(int* moves, MoveKey* keys, int count)
+{
+    for (int i = 1; i < count; i++) {
+        const int move = moves[i];
+        const MoveKey key = keys[i];
+        int j = i - 1;
+        while (j >= 0 && keys[j] > key) {
+            moves[j + 1] = moves[j];
+            keys[j + 1] = keys[j];
+            j--;
+        }
+        moves[j + 1] = move;
+        keys[j + 1] = key;
+    }
+}
+
+#endif // MOVEORDERING_H
@@ -0,0 +1,259 @@
+#include "paralleltreesearch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+ParallelTreeSearch::ParallelTreeSearch(const TourOptions& options, const ParallelSearchOptions& parallelOptions)
+    : m_options(options)
+    , m_parallelOptions(parallelOptions)
+{
+    int threadCount = parallelOptions.threadCount;
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (threadCount <= 0) {
+        threadCount = 1;
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        m_solvers.push_back(std::make_unique<KnightTourSolver>(options));
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+}
+
+void ParallelTreeSearch::setTranspositionTable(TranspositionTable* table)
+{
+    for (const std::unique_ptr<KnightTourSolver>& solver : m_solvers) {
+        solver->setTranspositionTable(table);
+    }
+}
+
+TourResult ParallelTreeSearch::solve(const Square& start, const SearchBudget& budget, const TourCallback& onTour)
+{
+    return solveFrom(std::vector<Square>(1, start), budget, onTour);
+}
+
+// 主人从队列头部取任务（按 Warnsdorff 顺序，最有希望的子树在前）
+bool ParallelTreeSearch::popLocal(int worker, Subtree& item)
+{
+    WorkQueue& queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.items.empty()) {
+        return false;
+    }
+    item = std::move(queue.items.front());
+    queue.items.pop_front();
+    return true;
+}
+
+// 拆分出的子树放入自己队列的尾部（窃取者从尾部取）
+void ParallelTreeSearch::pushLocal(int worker, Subtree&& item)
+{
+    WorkQueue& queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.items.push_back(std::move(item));
+}
+
+// 空闲线程从其他队列尾部窃取尚未探索的兄弟子树
+bool ParallelTreeSearch::steal(int thief, Subtree& item)
+{
+    const int count = threadCount();
+    for (int offset = 1; offset < count; offset++) {
+        WorkQueue& queue = *m_queues[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.items.empty()) {
+            item = std::move(queue.items.back());
+            queue.items.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+TourResult ParallelTreeSearch::solveFrom(const std::vector<Square>& prefix, const SearchBudget& budget,
+                                         const TourCallback& onTour)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point begin = Clock::now();
+    const Clock::time_point deadline = budget.timeLimitMs > 0
+                                           ? begin + std::chrono::milliseconds(budget.timeLimitMs)
+                                           : Clock::time_point::max();
+    const bool allSolutions = m_parallelOptions.mode == ParallelSearchMode::AllSolutions;
+    const int count = threadCount();
+
+    // 展开前沿并按搜索顺序轮流分配，使每个线程最先处理的都是较优的子树
+    std::vector<Subtree> frontier;
+    const TourResult expansion = m_solvers[0]->expandFrontier(prefix, m_parallelOptions.frontierDepth, frontier);
+    if (expansion.stopReason == StopReason::None) {
+        TourResult invalid; // 前缀无效（与 KnightTourSolver::solveFrom 一致）
+        invalid.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin).count();
+        return invalid;
+    }
+    for (auto& queue : m_queues) {
+        queue->items.clear();
+    }
+    for (size_t i = 0; i < frontier.size(); i++) {
+        m_queues[i % count]->items.push_back(std::move(frontier[i]));
+    }
+
+    std::atomic<bool> stop(false);           // 内部停止标志：有结论、超出预算或外部取消
+    std::atomic<long long> totalNodes(expansion.nodes);
+    std::atomic<int> activeCount(count);     // 正在搜索或即将取任务的线程数（为 0 且队列为空时不会再有新任务）
+    std::atomic<long long> totalTours(0);
+    std::mutex resultMutex;                  // 保护 winner、limitReason 与用户回调
+    std::condition_variable doneCondition;
+    TourResult winner;
+    bool hasWinner = false;
+    bool callbackStopped = false;
+    StopReason limitReason = StopReason::None;
+    SearchStats stats;                       // 各子树统计之和（SEARCH_STATS_ENABLED 时）
+    int doneCount = 0;
+
+    // 用户回调串行化：多个线程找到的路径依次交给调用方
+    const TourCallback serializedCallback = [&](const std::vector<Square>& path) {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        if (callbackStopped || !onTour(path)) {
+            callbackStopped = true;
+            stop.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    };
+    const TourCallback countOnly = [](const std::vector<Square>&) { return true; };
+    const TourCallback& workerCallback = onTour ? serializedCallback : countOnly;
+
+    // 取任务：队列都空时请求忙碌线程拆分，直到拿到任务或确认所有线程都已空闲
+    auto acquire = [&](int index, Subtree& item) {
+        if (popLocal(index, item) || steal(index, item)) {
+            return true;
+        }
+        activeCount.fetch_sub(1);
+        int victim = index;
+        while (!stop.load(std::memory_order_relaxed)) {
+            activeCount.fetch_add(1);
+            if (popLocal(index, item) || steal(index, item)) {
+                return true;
+            }
+            // 最后一个变为空闲的线程在减一之后还会再取一次，因此这里看到 0 时不会遗漏任务
+            if (activeCount.fetch_sub(1) == 1) {
+                break;
+            }
+            victim = (victim + 1) % count;
+            if (victim != index) {
+                m_solvers[victim]->requestSplit();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return false;
+    };
+
+    auto worker = [&](int index) {
+        KnightTourSolver& solver = *m_solvers[index];
+        const SplitCallback donate = [this, index](Subtree&& subtree) { pushLocal(index, std::move(subtree)); };
+        solver.setSplitCallback(&donate);
+        Subtree item;
+        while (!stop.load(std::memory_order_relaxed) && acquire(index, item)) {
+            // 为子树分配剩余预算（超时与节点上限对整个并行搜索生效）
+            SearchBudget itemBudget = budget;
+            itemBudget.cancelFlag = &stop;
+            if (budget.timeLimitMs > 0) {
+                const long long remainingMs =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+                if (remainingMs <= 0) {
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    limitReason = StopReason::Deadline;
+                    stop.store(true, std::memory_order_relaxed);
+                    break;
+                }
+                itemBudget.timeLimitMs = static_cast<int>(std::max(1LL, remainingMs));
+            }
+            if (budget.maxNodes > 0) {
+                const long long remainingNodes = budget.maxNodes - totalNodes.load(std::memory_order_relaxed);
+                if (remainingNodes <= 0) {
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    limitReason = StopReason::NodeLimit;
+                    stop.store(true, std::memory_order_relaxed);
+                    break;
+                }
+                itemBudget.maxNodes = remainingNodes;
+            }
+
+            TourResult result = allSolutions ? solver.enumerateFrom(item, workerCallback, itemBudget)
+                                             : solver.solveFrom(item, itemBudget);
+            totalNodes.fetch_add(result.nodes, std::memory_order_relaxed);
+            totalTours.fetch_add(result.tourCount, std::memory_order_relaxed);
+            if constexpr (SEARCH_STATS_ENABLED) {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                stats.merge(result.stats);
+            }
+
+            if (result.stopReason == StopReason::Exhausted) {
+                continue; // 子树已穷尽，继续取下一个
+            }
+
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (result.stopReason == StopReason::Solved) {
+                if (!allSolutions && !hasWinner) {
+                    winner = std::move(result);
+                    hasWinner = true;
+                }
+            } else if (result.stopReason == StopReason::Deadline || result.stopReason == StopReason::NodeLimit) {
+                if (limitReason == StopReason::None) {
+                    limitReason = result.stopReason;
+                }
+            }
+            stop.store(true, std::memory_order_relaxed);
+        }
+
+        solver.setSplitCallback(nullptr);
+        std::lock_guard<std::mutex> lock(resultMutex);
+        doneCount++;
+        doneCondition.notify_one();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+    for (int i = 0; i < count; i++) {
+        threads.emplace_back(worker, i);
+    }
+
+    // 等待全部线程结束；每 1ms 检查一次外部取消标志并转发
+    bool externallyCancelled = false;
+    {
+        std::unique_lock<std::mutex> lock(resultMutex);
+        while (doneCount < count) {
+            doneCondition.wait_for(lock, std::chrono::milliseconds(1));
+            if (!externallyCancelled && budget.cancelFlag
+                && budget.cancelFlag->load(std::memory_order_relaxed)) {
+                externallyCancelled = true;
+                stop.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    TourResult result;
+    if (hasWinner) {
+        result = std::move(winner);
+        result.stopReason = StopReason::Solved;
+    } else if (callbackStopped) {
+        result.stopReason = StopReason::Solved;
+    } else if (externallyCancelled) {
+        result.stopReason = StopReason::Cancelled;
+    } else if (limitReason != StopReason::None) {
+        result.stopReason = limitReason;
+    } else {
+        result.stopReason = StopReason::Exhausted; // 所有子树均已穷尽
+    }
+    result.tourCount = allSolutions ? totalTours.load() : (hasWinner ? 1 : 0);
+    result.success = result.tourCount > 0;
+    result.nodes = totalNodes.load();
+    result.stats = std::move(stats);
+    result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin).count();
+    return result;
+}
@@ -0,0 +1,94 @@
+#ifndef PARALLELTREESEARCH_H
+#define PARALLELTREESEARCH_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "knighttoursolver.h"
+
+/**
+ * @brief 并行搜索模式
+ */
+enum class ParallelSearchMode
+{
+    FirstSolution,   // 找到第一条路径即停止
+    AllSolutions     // 枚举全部路径
+};
+
+/**
+ * @brief 并行树搜索选项
+ */
+struct ParallelSearchOptions
+{
+    int threadCount = 0;                                  // 工作线程数，<=0 表示使用全部硬件线程
+    int frontierDepth = 4;                                // 前沿展开深度（在起点/前缀基础上再走几步）
+    ParallelSearchMode mode = ParallelSearchMode::FirstSolution;
+};
+
+/**
+ * @brief 工作窃取式并行回溯搜索
+ * 先把搜索树展开到 frontierDepth 层，得到的子树按搜索顺序轮流分配到各线程的双端队列；
+ * 线程从自己队列的头部（最优先的子树）取任务，空闲时从其他线程队列的尾部窃取尚未探索的兄弟子树。
+ * 所有队列都空而仍有线程在搜索时，空闲线程请求忙碌线程拆分（KnightTourSolver::requestSplit）：
+ * 忙碌线程在下一个预算检查点把栈中最浅一层尚未尝试的候选放入自己的队列，供空闲线程窃取，
+ * 因此一棵很深的前沿子树也能分给多个线程
+ * 每个线程持有独立的 KnightTourSolver（独立的棋盘状态与搜索栈）
+ */
+class ParallelTreeSearch
+{
+public:
+    explicit ParallelTreeSearch(const TourOptions& options = TourOptions(),
+                                const ParallelSearchOptions& parallelOptions = ParallelSearchOptions());
+
+    const TourOptions& options() const { return m_options; }
+    const ParallelSearchOptions& parallelOptions() const { return m_parallelOptions; }
+    int threadCount() const { return static_cast<int>(m_solvers.size()); }
+
+    /**
+     * @brief 设置所有线程共享的无解状态表（不持有，可为空）
+     */
+    void setTranspositionTable(TranspositionTable* table);
+
+    /**
+     * @brief 从起点并行搜索
+     * @param start 起始位置
+     * @param budget 搜索预算：超时与节点上限对整个并行搜索生效（各子树按开始时的剩余额度执行，节点数可能略超上限），
+     *               取消标志在 1ms 内传递到所有线程
+     * @param onTour 路径回调（AllSolutions 模式下每条路径调用一次，调用已串行化，返回 false 停止搜索）
+     * @return FirstSolution：获胜线程的路径；AllSolutions：tourCount 为路径总数（path 为空）。
+     *         nodes 为前沿展开与所有线程节点数之和；前缀无效时 stopReason 为 None
+     */
+    TourResult solve(const Square& start, const SearchBudget& budget = SearchBudget(),
+                     const TourCallback& onTour = TourCallback());
+
+    /**
+     * @brief 从路径前缀并行搜索（参数与返回值同 solve）
+     */
+    TourResult solveFrom(const std::vector<Square>& prefix, const SearchBudget& budget = SearchBudget(),
+                         const TourCallback& onTour = TourCallback());
+
+private:
+    using Subtree = std::vector<Square>; // 子树以其路径前缀表示
+
+    /**
+     * @brief 每个线程的任务队列（主人从头部取，窃取者从尾部取）
+     */
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Subtree> items;
+    };
+
+    bool popLocal(int worker, Subtree& item);
+    bool steal(int thief, Subtree& item);
+    void pushLocal(int worker, Subtree&& item);
+
+    TourOptions m_options;
+    ParallelSearchOptions m_parallelOptions;
+    std::vector<std::unique_ptr<KnightTourSolver>> m_solvers; // 每个线程一个求解器（保留搜索栈，重复求解时复用）
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;         // 每个线程一个任务队列
+};
+
+#endif // PARALLELTREESEARCH_H
@@ -0,0 +1,147 @@
+#include "portfoliosolver.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "tourfeasibility.h"
+
+PortfolioSolver::PortfolioSolver(const TourOptions& options, int instanceCount)
+    : m_options(options)
+{
+    if (instanceCount <= 0) {
+        instanceCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (instanceCount <= 0) {
+        instanceCount = 1;
+    }
+
+    m_solvers.reserve(instanceCount);
+    for (int i = 0; i < instanceCount; i++) {
+        m_solvers.push_back(std::make_unique<KnightTourSolver>());
+    }
+    setOptions(options);
+}
+
+void PortfolioSolver::setOptions(const TourOptions& options)
+{
+    m_options = options;
+    for (int i = 0; i < instanceCount(); i++) {
+        TourOptions instanceOptions = options;
+        instanceOptions.tieBreakSeed = seedForInstance(i);
+        m_solvers[i]->setOptions(instanceOptions);
+    }
+}
+
+void PortfolioSolver::setTranspositionTable(TranspositionTable* table)
+{
+    for (const std::unique_ptr<KnightTourSolver>& solver : m_solvers) {
+        solver->setTranspositionTable(table);
+    }
+}
+
+unsigned PortfolioSolver::seedForInstance(int index)
+{
+    // 第 0 个实例保留默认排序；其余实例使用互不相同的非零种子
+    return index == 0 ? 0u : 0x9E3779B9u * static_cast<unsigned>(index);
+}
+
+// 并行求解：最先得出确定结论（找到路径或穷尽搜索空间）的实例获胜
+TourResult PortfolioSolver::solve(const Square& start, const SearchBudget& budget)
+{
+    TourResult cached;
+    if (m_tourCache && m_tourCache->lookup(m_options, start, cached)) {
+        m_lastWinner = -1;
+        return cached;
+    }
+    // 预检查证明无解时不启动任何实例
+    const Infeasibility infeasibility = checkTourFeasibility(m_options, start);
+    if (infeasibility != Infeasibility::None) {
+        m_lastWinner = -1;
+        TourResult result;
+        result.stopReason = infeasibility == Infeasibility::InvalidStart ? StopReason::None : StopReason::Exhausted;
+        return result;
+    }
+
+    // 启动前已取消（计算刚提交就被新的请求取代）时不启动任何实例
+    if (budget.cancelFlag && budget.cancelFlag->load(std::memory_order_relaxed)) {
+        m_lastWinner = -1;
+        TourResult result;
+        result.stopReason = StopReason::Cancelled;
+        return result;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    const int count = instanceCount();
+
+    std::atomic<bool> raceOver(false); // 内部取消标志：有实例获胜或外部取消时置位
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    std::vector<TourResult> results(count);
+    int finishedCount = 0;
+    int winner = -1;
+
+    SearchBudget instanceBudget = budget;
+    instanceBudget.cancelFlag = &raceOver;
+
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+    for (int i = 0; i < count; i++) {
+        threads.emplace_back([&, i]() {
+            TourResult result = m_solvers[i]->solve(start, instanceBudget);
+            const bool conclusive = result.stopReason == StopReason::Solved
+                                    || result.stopReason == StopReason::Exhausted;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            results[i] = std::move(result);
+            finishedCount++;
+            if (conclusive && winner < 0) {
+                winner = i;
+                raceOver.store(true, std::memory_order_relaxed);
+            }
+            finishedCondition.notify_one();
+        });
+    }
+
+    // 等待获胜者或全部结束；每 1ms 检查一次外部取消标志并转发给各实例
+    bool externallyCancelled = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (winner < 0 && finishedCount < count) {
+            finishedCondition.wait_for(lock, std::chrono::milliseconds(1));
+            if (!externallyCancelled && budget.cancelFlag
+                && budget.cancelFlag->load(std::memory_order_relaxed)) {
+                externallyCancelled = true;
+                raceOver.store(true, std::memory_order_relaxed);
+            }
+        }
+        raceOver.store(true, std::memory_order_relaxed);
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    long long totalNodes = 0;
+    for (const TourResult& result : results) {
+        totalNodes += result.nodes;
+    }
+
+    TourResult result;
+    m_lastWinner = winner;
+    if (winner >= 0) {
+        result = std::move(results[winner]);
+    } else {
+        // 无实例得出结论：各实例预算相同，以第 0 个实例的终止原因为准
+        result.stopReason = externallyCancelled ? StopReason::Cancelled : results[0].stopReason;
+    }
+    result.nodes = totalNodes;
+    if (m_tourCache) {
+        m_tourCache->store(m_options, result);
+    }
+    result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - begin).count();
+    return result;
+}
@@ -0,0 +1,66 @@
+#ifndef PORTFOLIOSOLVER_H
+#define PORTFOLIOSOLVER_H
+
+#include <memory>
+#include <vector>
+
+#include "knighttoursolver.h"
+
+/**
+ * @brief 并行组合求解器（portfolio）
+ * 同时运行多个辅助排序不同的 KnightTourSolver 实例，每个实例占用一个线程，
+ * 最先找到路径的实例获胜，其余实例立即取消。
+ * 第 0 个实例始终使用默认的坐标序号排序，因此结果不会比单实例更差（不计线程竞争）
+ */
+class PortfolioSolver
+{
+public:
+    /**
+     * @param options 基础求解选项（tieBreakSeed 被各实例的种子覆盖）
+     * @param instanceCount 实例数量，<=0 表示使用全部硬件线程
+     */
+    explicit PortfolioSolver(const TourOptions& options = TourOptions(), int instanceCount = 0);
+
+    const TourOptions& options() const { return m_options; }
+    void setOptions(const TourOptions& options);
+
+    int instanceCount() const { return static_cast<int>(m_solvers.size()); }
+
+    /**
+     * @brief 设置闭合回路缓存（不持有，可为空）
+     * 命中时 solve 直接返回旋转后的缓存回路，不启动任何线程；未命中时保存获胜实例的回路
+     */
+    void setTourCache(TourCache* cache) { m_tourCache = cache; }
+
+    /**
+     * @brief 设置所有实例共享的无解状态表（不持有，可为空）
+     * 各实例搜索顺序不同，一个实例证明无解的状态可以直接被其他实例跳过
+     */
+    void setTranspositionTable(TranspositionTable* table);
+
+    /**
+     * @brief 并行求解
+     * @param start 起始位置（0-based）
+     * @param budget 搜索预算，对每个实例分别生效；取消标志在 1ms 内传递到所有实例
+     * @return 获胜实例的结果（nodes 为所有实例节点数之和）
+     */
+    TourResult solve(const Square& start, const SearchBudget& budget = SearchBudget());
+
+    /**
+     * @brief 上一次求解的获胜实例下标（-1 表示没有实例成功、结果来自缓存或预检查证明无解）
+     */
+    int lastWinner() const { return m_lastWinner; }
+
+    /**
+     * @brief 第 i 个实例使用的辅助排序种子（0 为坐标序号）
+     */
+    static unsigned seedForInstance(int index);
+
+private:
+    TourOptions m_options;
+    TourCache* m_tourCache = nullptr; // 闭合回路缓存（不持有）
+    std::vector<std::unique_ptr<KnightTourSolver>> m_solvers; // 各实例（保留搜索栈，重复求解时复用）
+    int m_lastWinner = -1;
+};
+
+#endif // PORTFOLIOSOLVER_H
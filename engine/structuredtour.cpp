@@ -0,0 +1,281 @@
+#include "structuredtour.h"
+
+#include <chrono>
+#include <vector>
+
+namespace {
+
+// 结构化小棋盘回路（格子按 x * height + y 编号，离线搜索得到）：
+// 四个角都包含 (0,1)-(2,0) 这条边（按角翻转）；角格只有两个邻居，它的两条边必然在回路中
+constexpr unsigned char BASE_TOUR_6X6[] = {
+    0, 13, 26, 30, 19, 32, 24, 20, 33, 29, 16, 5, 9, 1, 12, 25, 21, 34, 23, 10,
+    2, 6, 14, 22, 35, 27, 31, 18, 7, 3, 11, 15, 28, 17, 4, 8
+};
+
+constexpr unsigned char BASE_TOUR_6X8[] = {
+    0, 17, 32, 42, 25, 40, 34, 44, 38, 23, 6, 12, 2, 8, 18, 24, 41, 35, 45, 39,
+    29, 46, 31, 14, 4, 19, 9, 3, 13, 7, 22, 28, 43, 33, 16, 1, 11, 5, 15, 21,
+    36, 26, 20, 30, 47, 37, 27, 10
+};
+
+constexpr unsigned char BASE_TOUR_8X6[] = {
+    0, 8, 4, 17, 9, 5, 16, 3, 11, 22, 35, 46, 38, 42, 31, 18, 7, 20, 12, 1,
+    14, 6, 2, 10, 23, 27, 40, 29, 21, 25, 36, 44, 33, 41, 28, 15, 19, 30, 43, 39,
+    47, 34, 45, 32, 24, 37, 26, 13
+};
+
+constexpr unsigned char BASE_TOUR_8X8[] = {
+    0, 10, 4, 14, 31, 46, 63, 53, 47, 62, 52, 58, 48, 33, 16, 1, 11, 5, 15, 21,
+    6, 23, 38, 55, 61, 51, 57, 40, 50, 56, 41, 24, 9, 3, 18, 8, 25, 35, 20, 30,
+    36, 26, 32, 42, 59, 49, 43, 60, 45, 39, 54, 37, 27, 44, 29, 12, 22, 7, 13, 28,
+    34, 19, 2, 17
+};
+
+constexpr unsigned char BASE_TOUR_8X10[] = {
+    0, 12, 20, 1, 13, 5, 17, 9, 28, 7, 19, 38, 59, 78, 66, 74, 62, 70, 51, 72,
+    60, 41, 53, 61, 73, 65, 77, 69, 57, 49, 68, 76, 64, 45, 26, 18, 39, 47, 55, 67,
+    79, 58, 37, 29, 8, 16, 4, 25, 6, 27, 48, 56, 75, 63, 71, 50, 31, 10, 2, 14,
+    35, 43, 24, 36, 15, 3, 22, 30, 11, 32, 40, 52, 44, 23, 42, 34, 46, 54, 33, 21
+};
+
+constexpr unsigned char BASE_TOUR_10X8[] = {
+    0, 17, 32, 49, 64, 74, 57, 72, 66, 56, 73, 67, 77, 71, 54, 39, 22, 7, 13, 3,
+    9, 24, 41, 51, 68, 78, 63, 69, 79, 62, 47, 30, 15, 5, 11, 1, 16, 26, 20, 14,
+    31, 37, 52, 46, 61, 76, 70, 55, 45, 60, 75, 58, 48, 65, 59, 53, 43, 33, 50, 40,
+    34, 28, 38, 44, 29, 23, 6, 12, 18, 35, 25, 8, 2, 19, 36, 42, 27, 21, 4, 10
+};
+
+constexpr unsigned char BASE_TOUR_10X10[] = {
+    0, 21, 40, 61, 80, 92, 71, 90, 82, 70, 91, 83, 95, 87, 99, 78, 59, 38, 19, 7,
+    15, 3, 11, 30, 51, 72, 93, 81, 60, 52, 73, 94, 86, 98, 79, 58, 39, 18, 6, 27,
+    8, 29, 48, 69, 88, 96, 84, 63, 75, 67, 46, 65, 77, 89, 97, 85, 66, 74, 53, 32,
+    20, 1, 13, 5, 17, 9, 28, 49, 68, 76, 57, 36, 55, 47, 26, 34, 42, 50, 62, 41,
+    22, 10, 2, 14, 33, 54, 35, 43, 64, 45, 24, 16, 37, 56, 44, 25, 4, 23, 31, 12
+};
+
+constexpr unsigned char BASE_TOUR_10X12[] = {
+    0, 25, 48, 73, 96, 110, 85, 108, 98, 84, 109, 99, 113, 103, 117, 107, 82, 59, 34, 11,
+    21, 7, 17, 3, 13, 36, 61, 86, 72, 97, 111, 88, 74, 60, 50, 75, 100, 114, 89, 112,
+    87, 101, 115, 105, 119, 94, 71, 46, 23, 9, 32, 22, 47, 57, 80, 90, 104, 118, 95, 70,
+    93, 83, 106, 116, 102, 92, 69, 79, 65, 55, 78, 64, 41, 18, 8, 31, 6, 16, 2, 12,
+    26, 1, 24, 49, 63, 38, 15, 40, 30, 5, 19, 44, 54, 77, 67, 81, 91, 68, 45, 20,
+    10, 35, 58, 33, 56, 42, 28, 51, 76, 66, 43, 53, 39, 29, 52, 62, 37, 27, 4, 14
+};
+
+constexpr unsigned char BASE_TOUR_12X10[] = {
+    0, 12, 4, 16, 8, 29, 48, 69, 88, 109, 117, 98, 119, 107, 115, 103, 111, 90, 102, 110,
+    91, 70, 51, 30, 11, 3, 15, 7, 19, 27, 6, 18, 39, 58, 79, 67, 59, 38, 17, 9,
+    28, 49, 37, 25, 46, 34, 26, 5, 13, 1, 20, 32, 24, 36, 57, 78, 99, 118, 106, 114,
+    95, 116, 108, 89, 97, 105, 113, 101, 80, 92, 100, 112, 104, 96, 77, 85, 93, 81, 60, 72,
+    84, 76, 68, 87, 66, 47, 55, 74, 86, 65, 53, 45, 64, 56, 44, 63, 82, 94, 75, 83,
+    71, 50, 62, 41, 22, 43, 31, 10, 2, 23, 35, 14, 33, 52, 73, 54, 42, 61, 40, 21
+};
+
+constexpr int MIN_SPLIT_SIZE = 12; // 宽高都不小于 12 时切成四块，否则为小棋盘
+
+/**
+ * @brief 合并补丁：四块交汇处被删除的角边与新增的跨块边（相对合并中心的偏移）
+ * 左上块删除角格边 (-1,-1)-(-2,-3)，右上块删除 (0,-2)-(2,-1)，
+ * 右下块删除角格边 (0,0)-(1,2)，左下块删除 (-1,1)-(-3,0)；
+ * 新增 (-2,-3)-(0,-2)、(2,-1)-(0,0)、(1,2)-(-1,1)、(-3,0)-(-1,-1)，四个回路连成一个
+ */
+struct MergePatch
+{
+    MoveDelta cell;      // 受影响的格子
+    MoveDelta removed;   // 原回路中被删除的邻居
+    MoveDelta added;     // 替换后的邻居
+};
+
+constexpr MergePatch MERGE_PATCHES[] = {
+    {{-1, -1}, {-2, -3}, {-3, 0}},
+    {{-2, -3}, {-1, -1}, {0, -2}},
+    {{0, -2}, {2, -1}, {-2, -3}},
+    {{2, -1}, {0, -2}, {0, 0}},
+    {{0, 0}, {1, 2}, {2, -1}},
+    {{1, 2}, {0, 0}, {-1, 1}},
+    {{-1, 1}, {-3, 0}, {1, 2}},
+    {{-3, 0}, {-1, 1}, {-1, -1}}
+};
+
+// 切分一条边：两部分均为偶数且相差不超过 2，较短的在左/上
+int splitLow(int size)
+{
+    const int half = size / 2;
+    return half % 2 == 0 ? half : half - 1;
+}
+
+} // namespace
+
+/**
+ * @brief 小棋盘回路及其反查表（格子 -> 回路中的位置）
+ */
+struct StructuredTour::BaseTour
+{
+    int width;
+    int height;
+    const unsigned char* order;
+    std::vector<unsigned char> position;
+
+    BaseTour(int w, int h, const unsigned char* tour)
+        : width(w)
+        , height(h)
+        , order(tour)
+        , position(w * h)
+    {
+        for (int i = 0; i < w * h; i++) {
+            position[tour[i]] = static_cast<unsigned char>(i);
+        }
+    }
+};
+
+// 查找小棋盘回路（反查表只构建一次，线程安全）
+const StructuredTour::BaseTour* StructuredTour::findBase(int width, int height)
+{
+    static const std::vector<BaseTour> tours = {
+        BaseTour(6, 6, BASE_TOUR_6X6),
+        BaseTour(6, 8, BASE_TOUR_6X8),
+        BaseTour(8, 6, BASE_TOUR_8X6),
+        BaseTour(8, 8, BASE_TOUR_8X8),
+        BaseTour(8, 10, BASE_TOUR_8X10),
+        BaseTour(10, 8, BASE_TOUR_10X8),
+        BaseTour(10, 10, BASE_TOUR_10X10),
+        BaseTour(10, 12, BASE_TOUR_10X12),
+        BaseTour(12, 10, BASE_TOUR_12X10)
+    };
+
+    for (const BaseTour& tour : tours) {
+        if (tour.width == width && tour.height == height) {
+            return &tour;
+        }
+    }
+    return nullptr;
+}
+
+StructuredTour::StructuredTour(int width, int height)
+    : m_width(width)
+    , m_height(height)
+    , m_valid(isSupported(width, height))
+{
+}
+
+// 切分后四块的宽高仍为偶数、相差不超过 2，最终都落在预先计算的小棋盘上
+bool StructuredTour::isSupported(int width, int height)
+{
+    if (width < 6 || height < 6 || width % 2 != 0 || height % 2 != 0) {
+        return false;
+    }
+    return width - height <= 2 && height - width <= 2;
+}
+
+TourResult StructuredTour::solve(const Square& start, const std::atomic<bool>* cancelFlag) const
+{
+    const auto begin = std::chrono::steady_clock::now();
+    TourResult result;
+    if (!m_valid || !inBoard(start)) {
+        return result;
+    }
+
+    result.path.reserve(static_cast<size_t>(squareCount()));
+    const long long visited = walk(start, [&result, cancelFlag](const Square& sq) {
+        result.path.push_back(sq);
+        return !cancelFlag || result.path.size() % DEFAULT_BUDGET_CHECK_INTERVAL != 0
+               || !cancelFlag->load(std::memory_order_relaxed);
+    });
+    if (visited < squareCount()) {
+        result.path.clear();
+        result.stopReason = StopReason::Cancelled;
+    } else {
+        result.success = true;
+        result.stopReason = StopReason::Solved;
+        result.tourCount = 1;
+    }
+    result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - begin).count();
+    return result;
+}
+
+// 自顶向下定位小块；只保留与小块角重合的合并中心（其余中心的补丁不会落在本块内）
+void StructuredTour::locate(const Square& sq, Leaf& leaf) const
+{
+    int x0 = 0;
+    int y0 = 0;
+    int width = m_width;
+    int height = m_height;
+    Square centers[32];
+    int centerCount = 0;
+
+    while (width >= MIN_SPLIT_SIZE && height >= MIN_SPLIT_SIZE) {
+        const int left = splitLow(width);
+        const int top = splitLow(height);
+        const Square center(x0 + left, y0 + top);
+        centers[centerCount++] = center;
+
+        if (sq.x < center.x) {
+            width = left;
+        } else {
+            x0 = center.x;
+            width -= left;
+        }
+        if (sq.y < center.y) {
+            height = top;
+        } else {
+            y0 = center.y;
+            height -= top;
+        }
+    }
+
+    leaf.x0 = x0;
+    leaf.y0 = y0;
+    leaf.width = width;
+    leaf.height = height;
+    leaf.base = findBase(width, height);
+    leaf.centerCount = 0;
+    for (int i = 0; i < centerCount; i++) {
+        const Square& center = centers[i];
+        if ((center.x == x0 || center.x == x0 + width) && (center.y == y0 || center.y == y0 + height)) {
+            leaf.centers[leaf.centerCount++] = center;
+        }
+    }
+}
+
+// 前进一步：小块回路中的两个邻居，经合并补丁替换后，取不是上一格的那个
+void StructuredTour::advance(Walker& walker) const
+{
+    const Square current = walker.current;
+    Leaf& leaf = walker.leaf;
+    if (current.x < leaf.x0 || current.x >= leaf.x0 + leaf.width
+        || current.y < leaf.y0 || current.y >= leaf.y0 + leaf.height) {
+        locate(current, leaf);
+    }
+
+    const BaseTour& base = *leaf.base;
+    const int count = base.width * base.height;
+    const int position = base.position[(current.x - leaf.x0) * base.height + (current.y - leaf.y0)];
+    const int links[2] = { base.order[(position + 1) % count], base.order[(position + count - 1) % count] };
+    Square neighbors[2];
+    for (int i = 0; i < 2; i++) {
+        neighbors[i] = Square(leaf.x0 + links[i] / base.height, leaf.y0 + links[i] % base.height);
+    }
+
+    for (int c = 0; c < leaf.centerCount; c++) {
+        const int dx = current.x - leaf.centers[c].x;
+        const int dy = current.y - leaf.centers[c].y;
+        if (dx < -3 || dx > 2 || dy < -3 || dy > 2) {
+            continue;
+        }
+        for (const MergePatch& patch : MERGE_PATCHES) {
+            if (patch.cell.dx != dx || patch.cell.dy != dy) {
+                continue;
+            }
+            const Square removed(leaf.centers[c].x + patch.removed.dx, leaf.centers[c].y + patch.removed.dy);
+            for (Square& neighbor : neighbors) {
+                if (neighbor == removed) {
+                    neighbor = Square(leaf.centers[c].x + patch.added.dx, leaf.centers[c].y + patch.added.dy);
+                }
+            }
+        }
+    }
+
+    walker.current = neighbors[0] != walker.previous ? neighbors[0] : neighbors[1];
+    walker.previous = current;
+}
@@ -0,0 +1,123 @@
+#ifndef STRUCTUREDTOUR_H
+#define STRUCTUREDTOUR_H
+
+#include <atomic>
+
+#include "tourtypes.h"
+
+/**
+ * @brief 大棋盘闭合回路的分治构造（Parberry 方法）
+ * 把棋盘递归地切成四块，直到每块都是预先计算好的小棋盘（边长 6~12），
+ * 小棋盘的回路是"结构化"的：每个角上都包含角格的一条边和 (0,1)-(2,0) 这条边（按角翻转）。
+ * 合并时在四块交汇处各删除一条角边、补上四条跨块的马步，四个回路即连成一个，
+ * 外侧四个角保持不变，所以合并结果仍是结构化的，可以继续向上合并。
+ * 不保存整条路径：行走时只定位当前格子所在的小块（O(log n)，每块最多进入 4 次），
+ * 因此总时间 O(n²)、额外内存 O(1)，可以流式输出 10000x10000 棋盘的回路
+ */
+class StructuredTour
+{
+public:
+    /**
+     * @param width 棋盘宽度
+     * @param height 棋盘高度（不支持的尺寸构造后 isValid() 为 false）
+     */
+    StructuredTour(int width, int height);
+
+    /**
+     * @brief 是否支持该尺寸：宽高均为偶数且不小于 6、相差不超过 2（包括所有 n≥6 的偶数 n×n 棋盘）
+     */
+    static bool isSupported(int width, int height);
+
+    bool isValid() const { return m_valid; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    long long squareCount() const { return static_cast<long long>(m_width) * m_height; }
+
+    /**
+     * @brief 从 start 出发按回路顺序逐格访问（第 squareCount() 格之后一步回到 start）
+     * @param start 起始位置
+     * @param visit 访问函数 bool(const Square&)，每个格子调用一次，返回 false 时停止
+     * @return 已访问的格子数（尺寸或起点无效时为 0）
+     */
+    template <typename Visitor>
+    long long walk(const Square& start, Visitor&& visit) const;
+
+    /**
+     * @brief 生成完整路径（只适用于路径能放进内存的棋盘，大棋盘请使用 walk）
+     * @param cancelFlag 外部取消标志（可为空），每 DEFAULT_BUDGET_CHECK_INTERVAL 格检查一次
+     * @return 求解结果：成功时 stopReason 为 Solved、nodes 为 0；被取消时为 Cancelled（path 为空）；
+     *         尺寸或起点无效时为 None
+     */
+    TourResult solve(const Square& start, const std::atomic<bool>* cancelFlag = nullptr) const;
+
+private:
+    struct BaseTour;
+
+    /**
+     * @brief 当前所在的小块及其受合并影响的角（行走时缓存，离开小块才重新定位）
+     */
+    struct Leaf
+    {
+        int x0 = 0;
+        int y0 = 0;
+        int width = 0;
+        int height = 0;
+        const BaseTour* base = nullptr;
+        int centerCount = 0;           // 与本块某个角重合的合并中心数量（至多 4 个）
+        Square centers[4];             // 合并中心：左/上侧块的格子坐标小于中心
+    };
+
+    struct Walker
+    {
+        Leaf leaf;
+        Square previous;
+        Square current;
+    };
+
+    bool inBoard(const Square& sq) const
+    {
+        return sq.x >= 0 && sq.x < m_width && sq.y >= 0 && sq.y < m_height;
+    }
+
+    /**
+     * @brief 查找预先计算的小棋盘回路（尺寸不在表中时返回空）
+     */
+    static const BaseTour* findBase(int width, int height);
+
+    /**
+     * @brief 自顶向下定位格子所在的小块，并记录与小块角重合的合并中心
+     */
+    void locate(const Square& sq, Leaf& leaf) const;
+
+    /**
+     * @brief 前进一步：取当前格子在回路上的两个邻居中不是上一格的那个
+     */
+    void advance(Walker& walker) const;
+
+    int m_width = 0;
+    int m_height = 0;
+    bool m_valid = false;
+};
+
+template <typename Visitor>
+long long StructuredTour::walk(const Square& start, Visitor&& visit) const
+{
+    if (!m_valid || !inBoard(start)) {
+        return 0;
+    }
+
+    Walker walker;
+    walker.current = start;
+    locate(start, walker.leaf);
+
+    const long long total = squareCount();
+    for (long long i = 0; i < total; i++) {
+        if (!visit(walker.current)) {
+            return i + 1;
+        }
+        advance(walker);
+    }
+    return total;
+}
+
+#endif // STRUCTUREDTOUR_H
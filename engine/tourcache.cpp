@@ -0,0 +1,123 @@
+#include "tourcache.h"
+
+#include <chrono>
+
+#include "boardsymmetry.h"
+#include "tourvalidator.h"
+
+int TourCache::variantCount(int width, int height)
+{
+    return boardSymmetryCount(width, height) * 2;
+}
+
+// 查找缓存的回路；只有转置尺寸的回路时 transposed 置位
+std::shared_ptr<const TourCache::Cycle> TourCache::find(int width, int height, bool& transposed) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    transposed = false;
+    auto it = m_cycles.find(SizeKey(width, height));
+    if (it == m_cycles.end() && width != height) {
+        it = m_cycles.find(SizeKey(height, width));
+        transposed = true;
+    }
+    return it != m_cycles.end() ? it->second : nullptr;
+}
+
+// 查询：对缓存的回路做对称变换，找到起点后按所选方向旋转输出（不做任何搜索）
+bool TourCache::lookup(int width, int height, const Square& start, unsigned variant, std::vector<Square>& path) const
+{
+    if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) {
+        return false;
+    }
+
+    bool transposed = false;
+    const std::shared_ptr<const Cycle> cycle = find(width, height, transposed);
+    if (!cycle) {
+        return false;
+    }
+
+    const int symmetries = variantCount(width, height) / 2;
+    const int symmetry = static_cast<int>(variant % symmetries);
+    const bool reversed = (variant / symmetries) % 2 != 0;
+
+    auto mapped = [&](const Square& sq) {
+        const Square oriented = transposed ? Square(sq.y, sq.x) : sq;
+        return transformSquare(oriented, width, height, symmetry);
+    };
+
+    const int count = static_cast<int>(cycle->size());
+    int startIndex = -1;
+    for (int i = 0; i < count; i++) {
+        if (mapped((*cycle)[i]) == start) {
+            startIndex = i;
+            break;
+        }
+    }
+    if (startIndex < 0) {
+        return false;
+    }
+
+    path.clear();
+    path.reserve(count);
+    for (int i = 0; i < count; i++) {
+        const int index = reversed ? (startIndex - i + count) % count : (startIndex + i) % count;
+        path.push_back(mapped((*cycle)[index]));
+    }
+    return true;
+}
+
+bool TourCache::lookup(const TourOptions& options, const Square& start, TourResult& result) const
+{
+    if (!cacheable(options)) {
+        return false;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    TourResult hit;
+    if (!lookup(options.width, options.height, start, options.cacheVariant, hit.path)) {
+        return false;
+    }
+    hit.success = true;
+    hit.stopReason = StopReason::Solved;
+    hit.tourCount = 1;
+    hit.fromCache = true;
+    hit.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - begin).count();
+    result = std::move(hit);
+    return true;
+}
+
+// 保存前校验：格子数正确、无重复、每一步（含回到起点）均为马步
+bool TourCache::store(int width, int height, const std::vector<Square>& cycle)
+{
+    if (!TourValidator(width, height).validate(cycle, true).ok()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_cycles.count(SizeKey(width, height)) || m_cycles.count(SizeKey(height, width))) {
+        return false;
+    }
+    m_cycles[SizeKey(width, height)] = std::make_shared<const Cycle>(cycle);
+    return true;
+}
+
+bool TourCache::store(const TourOptions& options, const TourResult& result)
+{
+    if (!cacheable(options) || !result.success) {
+        return false;
+    }
+    return store(options.width, options.height, result.path);
+}
+
+bool TourCache::contains(int width, int height) const
+{
+    bool transposed = false;
+    return find(width, height, transposed) != nullptr;
+}
+
+void TourCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cycles.clear();
+}
@@ -0,0 +1,81 @@
+#ifndef TOURCACHE_H
+#define TOURCACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "tourtypes.h"
+
+/**
+ * @brief 闭合回路缓存（按棋盘尺寸保存一条哈密顿回路）
+ * 闭合回路上的每个格子都可以作为起点：查询时把缓存的回路旋转到以起点开头即可，
+ * 不需要重新搜索；还可以按棋盘对称（翻转/转置）与行进方向给出不同的变体。
+ * 线程安全，可在多个求解器之间共享
+ */
+class TourCache
+{
+public:
+    /**
+     * @brief 查询以 start 为起点的闭合回路
+     * @param width 棋盘宽度
+     * @param height 棋盘高度
+     * @param start 起始位置
+     * @param variant 变体序号：按 variant % variantCount() 选择对称变换与行进方向，0 为缓存中的原始回路
+     * @param path 输出：以 start 开头的完整回路（命中时覆盖）
+     * @return 是否命中（同尺寸或转置尺寸的回路已缓存）
+     */
+    bool lookup(int width, int height, const Square& start, unsigned variant, std::vector<Square>& path) const;
+
+    /**
+     * @brief 按求解选项查询（仅 cacheable 的选项可用缓存，变体由 options.cacheVariant 指定）
+     * @param result 输出：命中时为完整的求解结果（stopReason 为 Solved，nodes 为 0，fromCache 置位）
+     * @return 是否命中
+     */
+    bool lookup(const TourOptions& options, const Square& start, TourResult& result) const;
+
+    /**
+     * @brief 保存一条闭合回路（已有同尺寸回路时忽略）
+     * @param cycle 完整回路（末格须能一步回到首格），不满足条件时不保存
+     * @return 是否保存
+     */
+    bool store(int width, int height, const std::vector<Square>& cycle);
+
+    /**
+     * @brief 保存求解结果中的闭合回路（未成功或选项不可缓存时忽略）
+     */
+    bool store(const TourOptions& options, const TourResult& result);
+
+    /**
+     * @brief 是否已缓存该尺寸（或其转置尺寸）的回路
+     */
+    bool contains(int width, int height) const;
+
+    void clear();
+
+    /**
+     * @brief 该尺寸下可区分的变体数：对称变换数（正方形 8，矩形 4）× 行进方向 2
+     */
+    static int variantCount(int width, int height);
+
+    /**
+     * @brief 求解选项能否使用缓存：只缓存无障碍棋盘上马的闭合回路（回路按尺寸保存，不区分棋子与障碍）
+     */
+    static bool cacheable(const TourOptions& options)
+    {
+        return options.closed && options.leaper == LeaperType::Knight && options.obstacles.empty();
+    }
+
+private:
+    using Cycle = std::vector<Square>;
+    using SizeKey = std::pair<int, int>;
+
+    std::shared_ptr<const Cycle> find(int width, int height, bool& transposed) const;
+
+    mutable std::mutex m_mutex;
+    std::map<SizeKey, std::shared_ptr<const Cycle>> m_cycles; // (width, height) -> 回路（只读，查询时无需持锁）
+};
+
+#endif // TOURCACHE_H
@@ -0,0 +1,195 @@
+#include "tourenumerator.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "boardsymmetry.h"
+#include "leaper.h"
+
+namespace {
+
+ParallelSearchOptions allSolutions(ParallelSearchOptions options)
+{
+    options.mode = ParallelSearchMode::AllSolutions;
+    return options;
+}
+
+} // namespace
+
+TourEnumerator::TourEnumerator(const TourOptions& options, const ParallelSearchOptions& parallelOptions)
+    : m_options(options)
+    , m_search(options, allSolutions(parallelOptions))
+{
+}
+
+// 障碍布局在变换下不变时，路径的像仍只经过可用格子
+bool TourEnumerator::preservesObstacles(int symmetry) const
+{
+    if (symmetry == 0 || m_options.obstacles.empty()) {
+        return true;
+    }
+    for (int x = 0; x < m_options.width; x++) {
+        for (int y = 0; y < m_options.height; y++) {
+            const Square image = transformSquare(Square(x, y), m_options.width, m_options.height, symmetry);
+            if (isBlocked(Square(x, y)) != isBlocked(image)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 轨道像：按变换序号依次施加，只保留得到新格子的变换（恒等变换序号为 0，总在首位）
+std::vector<int> TourEnumerator::orbitImages(const Square& representative, const Square& fixed) const
+{
+    std::vector<int> symmetries;
+    std::vector<Square> images;
+    const int count = m_useSymmetry ? boardSymmetryCount(m_options.width, m_options.height) : 1;
+    for (int symmetry = 0; symmetry < count; symmetry++) {
+        if (inBoard(fixed) && transformSquare(fixed, m_options.width, m_options.height, symmetry) != fixed) {
+            continue;
+        }
+        if (!preservesObstacles(symmetry)) {
+            continue;
+        }
+        const Square image = transformSquare(representative, m_options.width, m_options.height, symmetry);
+        if (std::find(images.begin(), images.end(), image) == images.end()) {
+            images.push_back(image);
+            symmetries.push_back(symmetry);
+        }
+    }
+    return symmetries;
+}
+
+TourResult TourEnumerator::enumerateFrom(const Square& start, const TourCallback& onTour, const SearchBudget& budget)
+{
+    if (!inBoard(start) || isBlocked(start)) {
+        return TourResult();
+    }
+    return enumerateOrbits({StartOrbit{start, {0}}}, onTour, budget);
+}
+
+// 整盘枚举：每个起点轨道只搜索代表格子
+TourResult TourEnumerator::enumerateBoard(const TourCallback& onTour, const SearchBudget& budget)
+{
+    std::vector<StartOrbit> orbits;
+    std::vector<char> covered(static_cast<size_t>(m_options.width) * m_options.height, 0);
+    for (int x = 0; x < m_options.width; x++) {
+        for (int y = 0; y < m_options.height; y++) {
+            if (covered[x * m_options.height + y] || isBlocked(Square(x, y))) {
+                continue;
+            }
+            StartOrbit orbit{Square(x, y), orbitImages(Square(x, y), Square())};
+            for (int symmetry : orbit.images) {
+                const Square image = transformSquare(orbit.start, m_options.width, m_options.height, symmetry);
+                covered[image.x * m_options.height + image.y] = 1;
+            }
+            orbits.push_back(std::move(orbit));
+        }
+    }
+    return enumerateOrbits(orbits, onTour, budget);
+}
+
+TourResult TourEnumerator::enumerateOrbits(const std::vector<StartOrbit>& orbits, const TourCallback& onTour,
+                                           const SearchBudget& budget)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point begin = Clock::now();
+    const Clock::time_point deadline = budget.timeLimitMs > 0
+                                           ? begin + std::chrono::milliseconds(budget.timeLimitMs)
+                                           : Clock::time_point::max();
+
+    TourResult total;
+    total.stopReason = StopReason::Exhausted;
+    long long emitted = 0;
+
+    for (const StartOrbit& orbit : orbits) {
+        // 第一步的代表走法：在保持起点不动的对称变换下去重（没有可走的格子时只搜索起点本身）
+        std::vector<std::vector<Square>> prefixes;
+        std::vector<std::vector<int>> moveImages;
+        std::vector<Square> seenMoves;
+        for (const MoveDelta& dir : leaperDirections(m_options.leaper)) {
+            const Square move(orbit.start.x + dir.dx, orbit.start.y + dir.dy);
+            if (!inBoard(move) || isBlocked(move)
+                || std::find(seenMoves.begin(), seenMoves.end(), move) != seenMoves.end()) {
+                continue;
+            }
+            std::vector<int> images = orbitImages(move, orbit.start);
+            for (int symmetry : images) {
+                seenMoves.push_back(transformSquare(move, m_options.width, m_options.height, symmetry));
+            }
+            prefixes.push_back({orbit.start, move});
+            moveImages.push_back(std::move(images));
+        }
+        if (prefixes.empty()) {
+            prefixes.push_back({orbit.start});
+            moveImages.push_back({0});
+        }
+
+        for (size_t i = 0; i < prefixes.size(); i++) {
+            // 剩余预算（超时与节点上限对整个枚举生效）
+            SearchBudget itemBudget = budget;
+            if (budget.timeLimitMs > 0) {
+                const long long remainingMs =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+                if (remainingMs <= 0) {
+                    total.stopReason = StopReason::Deadline;
+                    break;
+                }
+                itemBudget.timeLimitMs = static_cast<int>(remainingMs);
+            }
+            if (budget.maxNodes > 0) {
+                if (total.nodes >= budget.maxNodes) {
+                    total.stopReason = StopReason::NodeLimit;
+                    break;
+                }
+                itemBudget.maxNodes = budget.maxNodes - total.nodes;
+            }
+
+            // 每条找到的路径按（起点变换 ∘ 第一步变换）输出全部对称像
+            const std::vector<int>& images = moveImages[i];
+            TourCallback emitImages;
+            if (onTour) {
+                emitImages = [&](const std::vector<Square>& path) {
+                    for (int startSymmetry : orbit.images) {
+                        for (int moveSymmetry : images) {
+                            m_imageBuffer.clear();
+                            for (const Square& sq : path) {
+                                const Square moved = transformSquare(sq, m_options.width, m_options.height,
+                                                                     moveSymmetry);
+                                m_imageBuffer.push_back(transformSquare(moved, m_options.width, m_options.height,
+                                                                        startSymmetry));
+                            }
+                            emitted++;
+                            if (!onTour(m_imageBuffer)) {
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                };
+            }
+
+            const TourResult result = m_search.solveFrom(prefixes[i], itemBudget, emitImages);
+            total.nodes += result.nodes;
+            total.stats.merge(result.stats);
+            if (!onTour) {
+                total.tourCount += result.tourCount * static_cast<long long>(orbit.images.size() * images.size());
+            }
+            if (result.stopReason != StopReason::Exhausted) {
+                total.stopReason = result.stopReason;
+                break;
+            }
+        }
+        if (total.stopReason != StopReason::Exhausted) {
+            break;
+        }
+    }
+
+    if (onTour) {
+        total.tourCount = emitted; // 提前停止时只统计已输出的路径
+    }
+    total.success = total.tourCount > 0;
+    total.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin).count();
+    return total;
+}
@@ -0,0 +1,102 @@
+#ifndef TOURENUMERATOR_H
+#define TOURENUMERATOR_H
+
+#include <vector>
+
+#include "paralleltreesearch.h"
+
+/**
+ * @brief 巡游路径的并行穷举与计数（利用棋盘对称性约简）
+ * 棋盘的每个对称变换把一条路径映射为另一条路径，因此只需搜索：
+ *   - 起点：每个对称轨道中的一个代表格子（整盘枚举时）；
+ *   - 第一步：在保持起点不动的对称变换下，每个轨道中的一个代表走法。
+ * 其余路径是已找到路径的对称像，计数时按轨道大小相乘，输出时逐一变换生成。
+ * 每个（起点，第一步）子树交给 ParallelTreeSearch 在所有线程上工作窃取式搜索，
+ * 路径通过回调逐条流出，不在内存中保存
+ * 路径按有向序列计数：同一条闭合回路从不同起点、沿不同方向走是不同的路径
+ */
+class TourEnumerator
+{
+public:
+    /**
+     * @param options 求解选项（closed 决定统计闭合回路还是开放路径）
+     * @param parallelOptions 并行选项（mode 固定为 AllSolutions）
+     */
+    explicit TourEnumerator(const TourOptions& options = TourOptions(),
+                            const ParallelSearchOptions& parallelOptions = ParallelSearchOptions());
+
+    const TourOptions& options() const { return m_options; }
+
+    /**
+     * @brief 是否使用对称约简（默认开启；关闭后逐个搜索每个起点与第一步，用于核对结果）
+     */
+    void setUseSymmetry(bool useSymmetry) { m_useSymmetry = useSymmetry; }
+    bool useSymmetry() const { return m_useSymmetry; }
+
+    /**
+     * @brief 设置无解状态表（不持有，可为空；各线程共享）
+     */
+    void setTranspositionTable(TranspositionTable* table) { m_search.setTranspositionTable(table); }
+
+    /**
+     * @brief 枚举从 start 出发的全部路径
+     * @param start 起始位置
+     * @param onTour 路径回调（可为空，仅计数；调用已串行化，返回 false 停止枚举）
+     * @param budget 搜索预算（对整个枚举生效）
+     * @return tourCount 为路径总数（含对称像）；完整枚举时 stopReason 为 Exhausted，
+     *         回调要求停止时为 Solved；nodes 为实际搜索的节点数
+     */
+    TourResult enumerateFrom(const Square& start, const TourCallback& onTour = TourCallback(),
+                             const SearchBudget& budget = SearchBudget());
+
+    /**
+     * @brief 枚举整个棋盘上（所有起点）的全部路径（参数与返回值同 enumerateFrom）
+     */
+    TourResult enumerateBoard(const TourCallback& onTour = TourCallback(),
+                              const SearchBudget& budget = SearchBudget());
+
+private:
+    /**
+     * @brief 起点轨道：代表格子与把代表映射到轨道中每个格子的对称变换
+     */
+    struct StartOrbit
+    {
+        Square start;
+        std::vector<int> images;
+    };
+
+    /**
+     * @brief 枚举若干起点轨道下的全部路径
+     */
+    TourResult enumerateOrbits(const std::vector<StartOrbit>& orbits, const TourCallback& onTour,
+                               const SearchBudget& budget);
+
+    /**
+     * @brief 把 representative 映射到其轨道中每个元素的对称变换（每个元素一个，恒等变换在首位）
+     * @param representative 代表格子
+     * @param fixed 必须保持不动的格子（无此约束时传入无效坐标）
+     */
+    std::vector<int> orbitImages(const Square& representative, const Square& fixed) const;
+
+    /**
+     * @brief 对称变换是否保持障碍布局不变（不保持的变换不参与约简）
+     */
+    bool preservesObstacles(int symmetry) const;
+
+    bool isBlocked(const Square& sq) const
+    {
+        return m_options.obstacles.test(sq.x * m_options.height + sq.y);
+    }
+
+    bool inBoard(const Square& sq) const
+    {
+        return sq.x >= 0 && sq.x < m_options.width && sq.y >= 0 && sq.y < m_options.height;
+    }
+
+    TourOptions m_options;
+    ParallelTreeSearch m_search;
+    bool m_useSymmetry = true;
+    std::vector<Square> m_imageBuffer; // 对称像缓冲（回调已串行化，复用即可）
+};
+
+#endif // TOURENUMERATOR_H
@@ -0,0 +1,119 @@
+#include "tourfeasibility.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "leaper.h"
+
+namespace {
+
+// 一遍扫描统计颜色与度数，再从起点洪泛检查连通性
+template <class Piece>
+Infeasibility checkFeasibility(const TourOptions& options, const Square& start)
+{
+    const int width = options.width;
+    const int height = options.height;
+    const ObstacleMask& obstacles = options.obstacles;
+    auto isFree = [&](int x, int y) {
+        return x >= 0 && x < width && y >= 0 && y < height && !obstacles.test(x * height + y);
+    };
+    if (!isFree(start.x, start.y)) {
+        return Infeasibility::InvalidStart;
+    }
+
+    int freeCount = 0;
+    int startColorCount = 0;
+    int isolatedCount = 0;
+    int leafCount = 0;       // 度数为 1 的格子数（不含起点）
+    bool startIsLeaf = false;
+    const int startColor = (start.x + start.y) & 1;
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+            if (!isFree(x, y)) {
+                continue;
+            }
+            freeCount++;
+            startColorCount += ((x + y) & 1) == startColor;
+            int degree = 0;
+            forEachLeap<Piece>([&](auto i) {
+                constexpr MoveDelta dir = Piece::directions[decltype(i)::value];
+                degree += isFree(x + dir.dx, y + dir.dy);
+            });
+            if (degree == 0) {
+                isolatedCount++;
+            } else if (degree == 1) {
+                if (x == start.x && y == start.y) {
+                    startIsLeaf = true;
+                } else {
+                    leafCount++;
+                }
+            }
+        }
+    }
+    if (freeCount == 1) {
+        // 只有起点一个格子：开放路径即为起点本身，闭合回路不存在
+        return options.closed ? Infeasibility::LowDegree : Infeasibility::None;
+    }
+
+    // 不变色的跳子（如骆驼）只能到达同色格子，由下面的连通性检查排除
+    if constexpr (Piece::changesColor) {
+        const int otherColorCount = freeCount - startColorCount;
+        const bool balanced = (options.closed || freeCount % 2 == 0)
+                                  ? startColorCount == otherColorCount
+                                  : startColorCount == otherColorCount + 1;
+        if (!balanced) {
+            return Infeasibility::ColorImbalance;
+        }
+    }
+
+    if (isolatedCount > 0 || (options.closed && (leafCount > 0 || startIsLeaf)) || leafCount > 1) {
+        return Infeasibility::LowDegree;
+    }
+
+    std::vector<char> reached(static_cast<size_t>(width) * height, 0);
+    std::vector<Square> stack;
+    stack.reserve(freeCount);
+    stack.push_back(start);
+    reached[start.x * height + start.y] = 1;
+    int reachedCount = 1;
+    while (!stack.empty()) {
+        const Square sq = stack.back();
+        stack.pop_back();
+        forEachLeap<Piece>([&](auto i) {
+            constexpr MoveDelta dir = Piece::directions[decltype(i)::value];
+            const int nx = sq.x + dir.dx;
+            const int ny = sq.y + dir.dy;
+            if (isFree(nx, ny) && !reached[nx * height + ny]) {
+                reached[nx * height + ny] = 1;
+                reachedCount++;
+                stack.push_back(Square(nx, ny));
+            }
+        });
+    }
+    return reachedCount == freeCount ? Infeasibility::None : Infeasibility::Disconnected;
+}
+
+} // namespace
+
+bool closedKnightTourExists(int width, int height)
+{
+    const int m = std::min(width, height);
+    const int n = std::max(width, height);
+    if (m % 2 == 1 && n % 2 == 1) {
+        return false;
+    }
+    if (m == 1 || m == 2 || m == 4) {
+        return false;
+    }
+    return !(m == 3 && (n == 4 || n == 6 || n == 8));
+}
+
+Infeasibility checkTourFeasibility(const TourOptions& options, const Square& start)
+{
+    const bool startInBoard = start.x >= 0 && start.x < options.width && start.y >= 0 && start.y < options.height;
+    if (options.closed && options.leaper == LeaperType::Knight && options.obstacles.empty() && startInBoard
+        && !closedKnightTourExists(options.width, options.height)) {
+        return Infeasibility::NoClosedTour;
+    }
+    return visitLeaper(options.leaper, [&](auto piece) { return checkFeasibility<decltype(piece)>(options, start); });
+}
@@ -0,0 +1,52 @@
+#ifndef TOURFEASIBILITY_H
+#define TOURFEASIBILITY_H
+
+#include "tourtypes.h"
+
+/**
+ * @brief 不可行的原因（快速预检查的结论）
+ */
+enum class Infeasibility
+{
+    None,            // 预检查通过（不代表一定有解）
+    InvalidStart,    // 起点在棋盘外或被阻挡
+    NoClosedTour,    // 该尺寸的棋盘上不存在马的闭合回路（Schwenk 定理）
+    ColorImbalance,  // 黑白格数量不满足交替要求
+    LowDegree,       // 有格子的可用邻居太少（孤立格、闭合回路中度数为 1、或多于一个必经终点）
+    Disconnected     // 可用格子不连通
+};
+
+/**
+ * @brief 不可行原因的文本表示（用于日志与机器可读输出）
+ */
+inline const char* infeasibilityName(Infeasibility reason)
+{
+    switch (reason) {
+    case Infeasibility::None:           return "none";
+    case Infeasibility::InvalidStart:   return "invalid_start";
+    case Infeasibility::NoClosedTour:   return "no_closed_tour";
+    case Infeasibility::ColorImbalance: return "color_imbalance";
+    case Infeasibility::LowDegree:      return "low_degree";
+    case Infeasibility::Disconnected:   return "disconnected";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Schwenk 定理：m x n 棋盘（m ≤ n）上存在马的闭合回路，当且仅当以下情况都不成立：
+ * m、n 都是奇数；m = 1、2 或 4；m = 3 且 n = 4、6 或 8
+ */
+bool closedKnightTourExists(int width, int height);
+
+/**
+ * @brief 路径存在性的快速预检查（必要条件，O(格子数)，8x8 上约 1μs）
+ * 无障碍棋盘上的马的闭合回路先按 Schwenk 定理判断（O(1)，定理给出的是充要条件）；
+ * 马步（以及 a + b 为奇数的其他跳子）总是改变格子颜色，路径上两种颜色交替出现：
+ * 闭合回路要求两色数量相等，开放路径要求起点颜色的格子数等于另一色或多一个；
+ * 每个格子至少要有一条（闭合回路为两条）可用边，只有一条的格子只能是路径端点（开放路径除起点外至多一个）；
+ * 可用格子须与起点连通。任一条件不满足即证明无解，不必搜索到超时
+ * @return 第一个不满足的条件；全部满足时为 None
+ */
+Infeasibility checkTourFeasibility(const TourOptions& options, const Square& start);
+
+#endif // TOURFEASIBILITY_H
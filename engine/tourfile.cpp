@@ -0,0 +1,435 @@
+#include "tourfile.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char TOUR_FILE_MAGIC[4] = {'K', 'N', 'T', 'R'};
+constexpr std::uint16_t TOUR_FILE_VERSION = 1;
+constexpr std::uint16_t FLAG_CLOSED = 1;
+
+void putLittle(unsigned char* out, std::uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+std::uint64_t getLittle(const unsigned char* in, int bytes)
+{
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+// 走法区字节数（含末尾补的 0 字节）
+std::uint64_t moveBytes(long long length)
+{
+    return (static_cast<std::uint64_t>(length - 1) * 3 + 7) / 8 + 1;
+}
+
+int moveIndex(const Square& from, const Square& to, LeaperType leaper)
+{
+    const std::array<MoveDelta, MOVE_COUNT>& directions = leaperDirections(leaper);
+    for (int k = 0; k < MOVE_COUNT; k++) {
+        if (from.x + directions[k].dx == to.x && from.y + directions[k].dy == to.y) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+// 文件名按 UTF-8 处理（Windows 下转换为宽字符，支持中文路径）
+std::FILE* openFile(const std::string& fileName, const char* mode)
+{
+#ifdef _WIN32
+    auto widen = [](const std::string& text) {
+        const int count = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, nullptr, 0);
+        std::wstring wide(count > 0 ? count : 1, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, &wide[0], count);
+        return wide;
+    };
+    return _wfopen(widen(fileName).c_str(), widen(mode).c_str());
+#else
+    return std::fopen(fileName.c_str(), mode);
+#endif
+}
+
+} // namespace
+
+// -------------------------- TourFileWriter --------------------------
+
+TourFileWriter::TourFileWriter(int chunkSize)
+    : m_chunkSize(chunkSize > 0 ? (chunkSize + 7) / 8 * 8 : 0) // 索引项落在字节边界上
+{
+}
+
+TourFileWriter::~TourFileWriter()
+{
+    if (m_file) {
+        std::fclose(m_file);
+    }
+}
+
+bool TourFileWriter::fail(const std::string& message)
+{
+    m_error = message;
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    return false;
+}
+
+bool TourFileWriter::open(const std::string& fileName, int width, int height, LeaperType leaper)
+{
+    if (m_file) {
+        std::fclose(m_file);
+    }
+    m_error.clear();
+    m_width = width;
+    m_height = height;
+    m_leaper = leaper;
+    m_start = m_last = Square();
+    m_length = 0;
+    m_bitBuffer = 0;
+    m_bitCount = 0;
+    m_bytes.clear();
+    m_index.clear();
+    if (width <= 0 || height <= 0) {
+        return fail("棋盘尺寸无效");
+    }
+
+    m_file = openFile(fileName, "wb");
+    if (!m_file) {
+        return fail("无法创建文件：" + fileName);
+    }
+    // 先占位写文件头，finish 时回填
+    const unsigned char header[TOUR_FILE_HEADER_SIZE] = {};
+    if (std::fwrite(header, 1, sizeof(header), m_file) != sizeof(header)) {
+        return fail("写入文件失败");
+    }
+    m_bytes.reserve(1 << 16);
+    return true;
+}
+
+bool TourFileWriter::flushBytes()
+{
+    if (!m_bytes.empty() && std::fwrite(m_bytes.data(), 1, m_bytes.size(), m_file) != m_bytes.size()) {
+        return fail("写入文件失败");
+    }
+    m_bytes.clear();
+    return true;
+}
+
+bool TourFileWriter::append(const Square& sq)
+{
+    if (!m_file) {
+        return false;
+    }
+    if (sq.x < 0 || sq.x >= m_width || sq.y < 0 || sq.y >= m_height) {
+        return fail("格子不在棋盘内");
+    }
+
+    if (m_length == 0) {
+        m_start = sq;
+    } else {
+        const int k = moveIndex(m_last, sq, m_leaper);
+        if (k < 0) {
+            return fail("相邻两格不是一步可达");
+        }
+        m_bitBuffer |= static_cast<std::uint32_t>(k) << m_bitCount;
+        m_bitCount += 3;
+        while (m_bitCount >= 8) {
+            m_bytes.push_back(static_cast<unsigned char>(m_bitBuffer));
+            m_bitBuffer >>= 8;
+            m_bitCount -= 8;
+        }
+        if (m_bytes.size() >= (1 << 16) && !flushBytes()) {
+            return false;
+        }
+    }
+    if (m_chunkSize > 0 && m_length % m_chunkSize == 0) {
+        m_index.push_back(sq);
+    }
+    m_last = sq;
+    m_length++;
+    return true;
+}
+
+bool TourFileWriter::finish()
+{
+    if (!m_file) {
+        return false;
+    }
+    if (m_length == 0) {
+        return fail("路径为空");
+    }
+
+    // 剩余的位与末尾的 0 字节
+    if (m_bitCount > 0) {
+        m_bytes.push_back(static_cast<unsigned char>(m_bitBuffer));
+    }
+    m_bytes.push_back(0);
+    if (!flushBytes()) {
+        return false;
+    }
+
+    const std::uint64_t indexOffset = TOUR_FILE_HEADER_SIZE + moveBytes(m_length);
+    for (const Square& sq : m_index) {
+        unsigned char entry[8];
+        putLittle(entry, static_cast<std::uint32_t>(sq.x), 4);
+        putLittle(entry + 4, static_cast<std::uint32_t>(sq.y), 4);
+        m_bytes.insert(m_bytes.end(), entry, entry + sizeof(entry));
+    }
+    if (!flushBytes()) {
+        return false;
+    }
+
+    const bool closed = m_length == static_cast<long long>(m_width) * m_height && m_length > 1
+                        && moveIndex(m_last, m_start, m_leaper) >= 0;
+    unsigned char header[TOUR_FILE_HEADER_SIZE] = {};
+    std::memcpy(header, TOUR_FILE_MAGIC, sizeof(TOUR_FILE_MAGIC));
+    putLittle(header + 4, TOUR_FILE_VERSION, 2);
+    putLittle(header + 6, closed ? FLAG_CLOSED : 0, 2);
+    putLittle(header + 8, m_width, 4);
+    putLittle(header + 12, m_height, 4);
+    putLittle(header + 16, m_start.x, 4);
+    putLittle(header + 20, m_start.y, 4);
+    putLittle(header + 24, m_length, 8);
+    putLittle(header + 32, m_chunkSize, 4);
+    putLittle(header + 36, static_cast<std::uint32_t>(m_leaper), 4);
+    putLittle(header + 40, TOUR_FILE_HEADER_SIZE, 8);
+    putLittle(header + 48, m_index.empty() ? 0 : indexOffset, 8);
+    putLittle(header + 56, m_index.size(), 8);
+    if (std::fseek(m_file, 0, SEEK_SET) != 0 || std::fwrite(header, 1, sizeof(header), m_file) != sizeof(header)) {
+        return fail("写入文件头失败");
+    }
+
+    const bool ok = std::fclose(m_file) == 0;
+    m_file = nullptr;
+    if (!ok) {
+        m_error = "关闭文件失败";
+    }
+    return ok;
+}
+
+// -------------------------- TourFile --------------------------
+
+TourFile::~TourFile()
+{
+    close();
+}
+
+bool TourFile::fail(const std::string& message)
+{
+    close();
+    m_error = message;
+    return false;
+}
+
+void TourFile::close()
+{
+    if (m_data) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+    }
+    m_data = m_moves = m_index = nullptr;
+    m_size = 0;
+    m_width = m_height = 0;
+    m_length = 0;
+    m_start = Square();
+    m_closed = false;
+    m_leaper = LeaperType::Knight;
+    m_directions = KnightLeaper::directions.data();
+    m_chunkSize = 0;
+}
+
+bool TourFile::open(const std::string& fileName)
+{
+    close();
+    m_error.clear();
+
+    // 只读映射：页面在访问时才由系统调入，打开大文件不需要读取内容
+#ifdef _WIN32
+    const int wideCount = MultiByteToWideChar(CP_UTF8, 0, fileName.c_str(), -1, nullptr, 0);
+    std::wstring wideName(wideCount > 0 ? wideCount : 1, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, fileName.c_str(), -1, &wideName[0], wideCount);
+    HANDLE file = CreateFileW(wideName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return fail("无法打开文件：" + fileName);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < TOUR_FILE_HEADER_SIZE) {
+        CloseHandle(file);
+        return fail("文件过小，不是路径文件");
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return fail("无法映射文件：" + fileName);
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); // 视图保持映射对象有效
+    if (!view) {
+        return fail("无法映射文件：" + fileName);
+    }
+    m_data = static_cast<const unsigned char*>(view);
+    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return fail("无法打开文件：" + fileName);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < TOUR_FILE_HEADER_SIZE) {
+        ::close(fd);
+        return fail("文件过小，不是路径文件");
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // 映射保持文件有效
+    if (view == MAP_FAILED) {
+        return fail("无法映射文件：" + fileName);
+    }
+    m_data = static_cast<const unsigned char*>(view);
+    m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+    // 校验文件头与各区范围（之后的解码不再做边界检查）
+    const unsigned char* header = m_data;
+    if (std::memcmp(header, TOUR_FILE_MAGIC, sizeof(TOUR_FILE_MAGIC)) != 0) {
+        return fail("不是路径文件");
+    }
+    if (getLittle(header + 4, 2) != TOUR_FILE_VERSION) {
+        return fail("不支持的文件版本");
+    }
+    const std::uint64_t width = getLittle(header + 8, 4);
+    const std::uint64_t height = getLittle(header + 12, 4);
+    const std::uint64_t startX = getLittle(header + 16, 4);
+    const std::uint64_t startY = getLittle(header + 20, 4);
+    const std::uint64_t length = getLittle(header + 24, 8);
+    const std::uint64_t chunkSize = getLittle(header + 32, 4);
+    const std::uint64_t leaper = getLittle(header + 36, 4);
+    const std::uint64_t movesOffset = getLittle(header + 40, 8);
+    const std::uint64_t indexOffset = getLittle(header + 48, 8);
+    const std::uint64_t indexCount = getLittle(header + 56, 8);
+    if (width == 0 || height == 0 || width > INT32_MAX || height > INT32_MAX || startX >= width || startY >= height) {
+        return fail("文件头中的棋盘尺寸或起点无效");
+    }
+    if (length == 0 || length > width * height) {
+        return fail("文件头中的格子数无效");
+    }
+    if (leaper > static_cast<std::uint64_t>(LeaperType::Giraffe)) {
+        return fail("文件头中的棋子无效");
+    }
+    if (movesOffset < TOUR_FILE_HEADER_SIZE || movesOffset > m_size || moveBytes(length) > m_size - movesOffset) {
+        return fail("走法区超出文件范围");
+    }
+    if (chunkSize % 8 != 0 || (chunkSize > 0 && indexCount != (length + chunkSize - 1) / chunkSize)) {
+        return fail("索引区无效");
+    }
+    if (chunkSize > 0 && (indexOffset > m_size || indexCount > (m_size - indexOffset) / 8)) {
+        return fail("索引区超出文件范围");
+    }
+
+    m_width = static_cast<int>(width);
+    m_height = static_cast<int>(height);
+    m_start = Square(static_cast<int>(startX), static_cast<int>(startY));
+    m_length = static_cast<long long>(length);
+    m_closed = (getLittle(header + 6, 2) & FLAG_CLOSED) != 0;
+    m_leaper = static_cast<LeaperType>(leaper);
+    m_directions = leaperDirections(m_leaper).data();
+    m_chunkSize = static_cast<int>(chunkSize);
+    m_moves = m_data + movesOffset;
+    m_index = chunkSize > 0 ? m_data + indexOffset : nullptr;
+    return true;
+}
+
+// 从最近的索引项向后解码（无索引时从起点解码）
+Square TourFile::at(long long step) const
+{
+    if (!m_data || step < 0 || step >= m_length) {
+        return Square();
+    }
+    long long from = 0;
+    Square sq = m_start;
+    if (m_chunkSize > 0) {
+        const long long chunk = step / m_chunkSize;
+        from = chunk * m_chunkSize;
+        sq = Square(static_cast<int>(getLittle(m_index + chunk * 8, 4)),
+                    static_cast<int>(getLittle(m_index + chunk * 8 + 4, 4)));
+    }
+    for (long long i = from; i < step; i++) {
+        const MoveDelta& delta = move(i);
+        sq.x += delta.dx;
+        sq.y += delta.dy;
+    }
+    return sq;
+}
+
+TourFile::Cursor TourFile::cursor(long long step) const
+{
+    Cursor cursor;
+    cursor.m_file = this;
+    cursor.m_step = step;
+    cursor.m_square = at(step);
+    return cursor;
+}
+
+TourFile::Cursor TourFile::cursor(long long step, const Square& square) const
+{
+    Cursor cursor;
+    cursor.m_file = this;
+    cursor.m_step = step;
+    cursor.m_square = square;
+    return cursor;
+}
+
+bool TourFile::toPath(std::vector<Square>& path) const
+{
+    path.clear();
+    if (!m_data) {
+        return false;
+    }
+    path.reserve(static_cast<std::size_t>(m_length));
+    Cursor walker = cursor(0);
+    do {
+        const Square& sq = walker.square();
+        if (sq.x < 0 || sq.x >= m_width || sq.y < 0 || sq.y >= m_height) {
+            path.clear();
+            return false;
+        }
+        path.push_back(sq);
+    } while (walker.next());
+    return true;
+}
+
+bool TourFile::save(const std::string& fileName, int width, int height, const std::vector<Square>& path,
+                    std::string* error, LeaperType leaper)
+{
+    TourFileWriter writer;
+    bool ok = writer.open(fileName, width, height, leaper);
+    for (size_t i = 0; ok && i < path.size(); i++) {
+        ok = writer.append(path[i]);
+    }
+    ok = ok && writer.finish();
+    if (!ok && error) {
+        *error = writer.errorString();
+    }
+    return ok;
+}
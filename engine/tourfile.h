@@ -0,0 +1,209 @@
+#ifndef TOURFILE_H
+#define TOURFILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "leaper.h"
+#include "tourtypes.h"
+
+constexpr int TOUR_FILE_HEADER_SIZE = 64;        // 文件头字节数
+constexpr int DEFAULT_TOUR_FILE_CHUNK = 4096;    // 默认每 4096 步记录一个索引项（须为 8 的倍数）
+
+static_assert(MOVE_COUNT <= 8, "每步走法按 3 位编码");
+
+/**
+ * @brief 巡游路径的紧凑二进制文件格式（所有整数均为小端序）
+ *   文件头（64 字节）：
+ *     0  "KNTR"           4  版本 u16 (=1)       6  标志 u16（bit0=闭合回路）
+ *     8  宽度 u32         12 高度 u32            16 起点 x u32        20 起点 y u32
+ *     24 格子数 u64       32 索引间隔 u32（0=无索引）                 36 棋子 u32（LeaperType，0=马）
+ *     40 走法区偏移 u64   48 索引区偏移 u64      56 索引项数 u64
+ *   走法区：第 i 步（path[i] -> path[i+1]）为该棋子走法表（leaperDirections）的下标，每步 3 位，低位在前连续打包，
+ *           末尾补一个 0 字节（解码时可以无条件读取两个字节）
+ *   索引区：第 k 项为第 k * 索引间隔 个格子的坐标（x u32, y u32），用于随机访问
+ * 格子数为 n 的路径占 3(n-1)/8 字节（8x8 为 24 字节，QVector<QPoint> 为 512 字节）
+ */
+
+/**
+ * @brief 流式写入路径文件（逐格追加，内存占用与路径长度无关，适合大棋盘的构造式回路）
+ */
+class TourFileWriter
+{
+public:
+    /**
+     * @param chunkSize 索引间隔（步，向上取整为 8 的倍数；0 表示不写索引）
+     */
+    explicit TourFileWriter(int chunkSize = DEFAULT_TOUR_FILE_CHUNK);
+    ~TourFileWriter();
+
+    TourFileWriter(const TourFileWriter&) = delete;
+    TourFileWriter& operator=(const TourFileWriter&) = delete;
+
+    /**
+     * @brief 创建文件（已存在时覆盖）
+     * @param fileName 文件名（UTF-8）
+     * @param leaper 路径所用的棋子（决定走法编码）
+     */
+    bool open(const std::string& fileName, int width, int height, LeaperType leaper = LeaperType::Knight);
+
+    /**
+     * @brief 追加下一个格子（第一个格子为起点）
+     * @return 格子不在棋盘内、不是上一格的一步或文件写入失败时返回 false
+     */
+    bool append(const Square& sq);
+
+    /**
+     * @brief 写入索引与文件头并关闭文件（未调用 finish 的文件是不完整的）
+     */
+    bool finish();
+
+    const std::string& errorString() const { return m_error; }
+
+private:
+    bool fail(const std::string& message);
+    bool flushBytes();
+
+    int m_chunkSize = 0;
+    std::FILE* m_file = nullptr;
+    int m_width = 0;
+    int m_height = 0;
+    LeaperType m_leaper = LeaperType::Knight;
+    Square m_start;
+    Square m_last;
+    long long m_length = 0;
+    std::uint32_t m_bitBuffer = 0;         // 尚未写出的走法位
+    int m_bitCount = 0;
+    std::vector<unsigned char> m_bytes;    // 写缓冲
+    std::vector<Square> m_index;           // 索引项（每 m_chunkSize 步一项，远小于路径本身）
+    std::string m_error;
+};
+
+/**
+ * @brief 以内存映射方式只读打开路径文件，按需解码
+ * 打开只校验文件头与各区大小（O(1)），不展开路径：
+ *   - Cursor 顺序解码，每步 O(1)；
+ *   - at() 借助索引随机访问，O(索引间隔)。
+ * 多 GB 的路径文件可以立即打开并从任意位置开始播放
+ */
+class TourFile
+{
+public:
+    TourFile() = default;
+    ~TourFile();
+
+    TourFile(const TourFile&) = delete;
+    TourFile& operator=(const TourFile&) = delete;
+
+    /**
+     * @brief 顺序解码游标
+     */
+    class Cursor
+    {
+    public:
+        long long step() const { return m_step; }
+        const Square& square() const { return m_square; }
+
+        /**
+         * @brief 前进一步
+         * @return 已经是最后一个格子时返回 false（位置不变）
+         */
+        bool next();
+
+    private:
+        friend class TourFile;
+
+        const TourFile* m_file = nullptr;
+        long long m_step = 0;
+        Square m_square;
+    };
+
+    /**
+     * @brief 打开并映射文件
+     * @param fileName 文件名（UTF-8）
+     */
+    bool open(const std::string& fileName);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    long long length() const { return m_length; }
+    Square start() const { return m_start; }
+    bool isClosed() const { return m_closed; }
+    bool hasIndex() const { return m_chunkSize > 0; }
+    LeaperType leaper() const { return m_leaper; }
+
+    /**
+     * @brief 第 step 个格子（0-based）
+     */
+    Square at(long long step) const;
+
+    /**
+     * @brief 从第 step 个格子开始的解码游标
+     */
+    Cursor cursor(long long step = 0) const;
+
+    /**
+     * @brief 从已知坐标的第 step 个格子开始的解码游标（调用者自己记录了该格坐标，不查索引，O(1)）
+     */
+    Cursor cursor(long long step, const Square& square) const;
+
+    /**
+     * @brief 第 step 步的走法（path[step] -> path[step+1]）
+     */
+    const MoveDelta& move(long long step) const;
+
+    /**
+     * @brief 展开为完整路径（只适用于能放进内存的路径），同时校验每个格子都在棋盘内
+     */
+    bool toPath(std::vector<Square>& path) const;
+
+    const std::string& errorString() const { return m_error; }
+
+    /**
+     * @brief 把完整路径写入文件（TourFileWriter 的便捷封装）
+     */
+    static bool save(const std::string& fileName, int width, int height, const std::vector<Square>& path,
+                     std::string* error = nullptr, LeaperType leaper = LeaperType::Knight);
+
+private:
+    bool fail(const std::string& message);
+
+    const unsigned char* m_data = nullptr; // 映射的文件内容
+    std::size_t m_size = 0;
+    int m_width = 0;
+    int m_height = 0;
+    long long m_length = 0;
+    Square m_start;
+    bool m_closed = false;
+    LeaperType m_leaper = LeaperType::Knight;
+    const MoveDelta* m_directions = KnightLeaper::directions.data(); // 走法编码对应的方向表
+    int m_chunkSize = 0;
+    const unsigned char* m_moves = nullptr;
+    const unsigned char* m_index = nullptr;
+    std::string m_error;
+};
+
+inline const MoveDelta& TourFile::move(long long step) const
+{
+    const std::uint64_t bit = static_cast<std::uint64_t>(step) * 3;
+    const unsigned pair = m_moves[bit / 8] | (static_cast<unsigned>(m_moves[bit / 8 + 1]) << 8);
+    return m_directions[(pair >> (bit % 8)) & 7];
+}
+
+inline bool TourFile::Cursor::next()
+{
+    if (m_step + 1 >= m_file->length()) {
+        return false;
+    }
+    const MoveDelta& delta = m_file->move(m_step);
+    m_square.x += delta.dx;
+    m_square.y += delta.dy;
+    m_step++;
+    return true;
+}
+
+#endif // TOURFILE_H
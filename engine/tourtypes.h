@@ -0,0 +1,253 @@
+#ifndef TOURTYPES_H
+#define TOURTYPES_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+// 常量集中定义（引擎与界面共用）
+constexpr int DEFAULT_BOARD_SIZE = 8;          // 默认棋盘大小（8x8）
+constexpr int MAX_BACKTRACK_TIME = 3000;       // 回溯算法默认超时时间（ms）
+constexpr int MOVE_COUNT = 8;                  // 每步的移动方向数量（马与其他 (a, b) 跳子均为 8）
+constexpr int DEFAULT_BUDGET_CHECK_INTERVAL = 4096; // 默认每 4096 个节点检查一次时钟与取消标志
+
+// 搜索统计开关：定义 KNIGHTTOUR_SEARCH_STATS 时收集（qmake: CONFIG+=search_stats，调试构建默认开启），
+// 否则统计代码全部编译掉，热路径没有任何额外开销
+#ifdef KNIGHTTOUR_SEARCH_STATS
+constexpr bool SEARCH_STATS_ENABLED = true;
+#else
+constexpr bool SEARCH_STATS_ENABLED = false;
+#endif
+
+/**
+ * @brief 跳子类型（(a, b) 跳子：每步沿一个轴走 a 格、另一个轴走 b 格，编译期走法表见 leaper.h）
+ */
+enum class LeaperType
+{
+    Knight,     // 马 (1, 2)
+    Camel,      // 骆驼 (1, 3)
+    Zebra,      // 斑马 (2, 3)
+    Giraffe     // 长颈鹿 (1, 4)
+};
+
+/**
+ * @brief 跳子类型的文本表示（用于日志与机器可读输出）
+ */
+inline const char* leaperName(LeaperType leaper)
+{
+    switch (leaper) {
+    case LeaperType::Knight:  return "knight";
+    case LeaperType::Camel:   return "camel";
+    case LeaperType::Zebra:   return "zebra";
+    case LeaperType::Giraffe: return "giraffe";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief 移动方向（相对坐标）
+ */
+struct MoveDelta
+{
+    int dx;
+    int dy;
+};
+
+// 马的8种移动方向 (dx, dy)
+constexpr MoveDelta MOVE_DIRECTIONS[MOVE_COUNT] = {
+    {2, 1}, {1, 2}, {-1, 2}, {-2, 1},
+    {-2, -1}, {-1, -2}, {1, -2}, {2, -1}
+};
+
+/**
+ * @brief 棋盘坐标（0-based），不依赖 Qt，便于无界面环境使用
+ */
+struct Square
+{
+    int x = -1;
+    int y = -1;
+
+    constexpr Square() = default;
+    constexpr Square(int px, int py) : x(px), y(py) {}
+
+    constexpr bool operator==(const Square& other) const { return x == other.x && y == other.y; }
+    constexpr bool operator!=(const Square& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief 障碍格子集合（位集，按一维下标 x * height + y 存储）
+ * 被阻挡的格子不能经过，路径只需走遍其余格子；下标与棋盘高度有关，尺寸改变后需重新设置
+ */
+struct ObstacleMask
+{
+    std::vector<std::uint64_t> words;          // 第 i 位为 1 表示第 i 个格子被阻挡（超出部分视为未阻挡）
+
+    bool test(int index) const
+    {
+        const size_t word = static_cast<size_t>(index) >> 6;
+        return word < words.size() && ((words[word] >> (index & 63)) & 1) != 0;
+    }
+
+    void set(int index, bool blocked = true)
+    {
+        const size_t word = static_cast<size_t>(index) >> 6;
+        if (word >= words.size()) {
+            if (!blocked) {
+                return;
+            }
+            words.resize(word + 1, 0);
+        }
+        const std::uint64_t bit = std::uint64_t(1) << (index & 63);
+        words[word] = blocked ? (words[word] | bit) : (words[word] & ~bit);
+    }
+
+    void toggle(int index) { set(index, !test(index)); }
+
+    /**
+     * @brief 被阻挡的格子数
+     */
+    int count() const
+    {
+        int total = 0;
+        for (std::uint64_t word : words) {
+            total += static_cast<int>(std::bitset<64>(word).count());
+        }
+        return total;
+    }
+
+    bool empty() const
+    {
+        return std::all_of(words.begin(), words.end(), [](std::uint64_t word) { return word == 0; });
+    }
+
+    void clear() { words.clear(); }
+};
+
+/**
+ * @brief 求解选项
+ */
+struct TourOptions
+{
+    int width = DEFAULT_BOARD_SIZE;            // 棋盘宽度（列数）
+    int height = DEFAULT_BOARD_SIZE;           // 棋盘高度（行数）
+    bool closed = true;                        // true=要求闭合回路（哈密顿回路），false=开放路径即可
+    LeaperType leaper = LeaperType::Knight;    // 棋子（马或其他 (a, b) 跳子）
+    unsigned tieBreakSeed = 0;                 // Warnsdorff 同度数时的辅助排序：0=坐标序号，其他=按种子随机排列
+    unsigned cacheVariant = 0;                 // 闭合回路缓存命中时使用的对称变体（见 TourCache::lookup）
+    bool forwardChecking = true;               // 前向检查：出现不可达格子或多个必须作为终点的格子时立即回溯
+    int connectivityInterval = 0;              // 路径长度每增加多少检查一次未访问格子的连通性（0=不检查）
+    bool bitboard = true;                      // 宽、高不超过 8 时使用位棋盘快速路径（关闭后走通用路径，用于核对结果）
+    ObstacleMask obstacles;                    // 障碍格子（为空表示所有格子可用）
+
+    /**
+     * @brief 路径需要走过的格子数（不含障碍格子）
+     */
+    int squareCount() const { return width * height - obstacles.count(); }
+};
+
+/**
+ * @brief 搜索预算（每次求解可单独指定）
+ * 时钟与取消标志每 checkInterval 个节点检查一次，节点上限精确生效
+ */
+struct SearchBudget
+{
+    int timeLimitMs = MAX_BACKTRACK_TIME;      // 超时时间（ms），<=0 表示不限时
+    long long maxNodes = 0;                    // 最大搜索节点数（达到上限时报告的节点数恰为该值），<=0 表示不限
+    const std::atomic<bool>* cancelFlag = nullptr; // 外部取消标志（可跨线程设置），为空表示不可取消
+    int checkInterval = DEFAULT_BUDGET_CHECK_INTERVAL; // 时钟/取消检查间隔（节点数）
+};
+
+/**
+ * @brief 搜索终止原因
+ */
+enum class StopReason
+{
+    None,        // 未执行（起点无效等）
+    Solved,      // 找到有效路径
+    Exhausted,   // 搜索空间穷尽，不存在满足条件的路径
+    Deadline,    // 超时
+    NodeLimit,   // 达到节点上限
+    Cancelled,   // 被外部取消
+    DeadEnd      // 无回溯的启发式构造走入死路（不代表无解，可回退到完整搜索）
+};
+
+/**
+ * @brief 终止原因的文本表示（用于日志与机器可读输出）
+ */
+inline const char* stopReasonName(StopReason reason)
+{
+    switch (reason) {
+    case StopReason::None:      return "none";
+    case StopReason::Solved:    return "solved";
+    case StopReason::Exhausted: return "exhausted";
+    case StopReason::Deadline:  return "deadline";
+    case StopReason::NodeLimit: return "node_limit";
+    case StopReason::Cancelled: return "cancelled";
+    case StopReason::DeadEnd:   return "dead_end";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief 搜索统计（仅在 SEARCH_STATS_ENABLED 时收集，否则 enabled 为 false、其余字段为初始值）
+ * 深度均以路径长度（已走格子数）计
+ */
+struct SearchStats
+{
+    bool enabled = false;                      // 本次结果是否收集了统计
+    long long backtracks = 0;                  // 回溯次数（撤销一个格子计一次）
+    long long prunes = 0;                      // 前向检查/连通性检查剪掉的子树数
+    int maxDepth = 0;                          // 到达的最大路径长度
+    int firstBacktrackDepth = -1;              // 第一次回溯时的路径长度（-1 表示没有回溯）
+    std::vector<std::array<long long, MOVE_COUNT + 1>> branching; // branching[d][k]：路径长度 d+1 处有 k 个候选的次数
+    long long moveGenNs = 0;                   // 走法生成耗时（ns）
+    long long orderingNs = 0;                  // Warnsdorff 排序耗时（ns）
+
+    /**
+     * @brief 合并另一次搜索的统计（并行搜索汇总各线程）
+     */
+    void merge(const SearchStats& other)
+    {
+        if (!other.enabled) {
+            return;
+        }
+        enabled = true;
+        if (other.firstBacktrackDepth >= 0
+            && (firstBacktrackDepth < 0 || other.firstBacktrackDepth < firstBacktrackDepth)) {
+            firstBacktrackDepth = other.firstBacktrackDepth;
+        }
+        backtracks += other.backtracks;
+        prunes += other.prunes;
+        maxDepth = std::max(maxDepth, other.maxDepth);
+        if (branching.size() < other.branching.size()) {
+            branching.resize(other.branching.size());
+        }
+        for (size_t d = 0; d < other.branching.size(); d++) {
+            for (int k = 0; k <= MOVE_COUNT; k++) {
+                branching[d][k] += other.branching[d][k];
+            }
+        }
+        moveGenNs += other.moveGenNs;
+        orderingNs += other.orderingNs;
+    }
+};
+
+/**
+ * @brief 求解结果
+ */
+struct TourResult
+{
+    bool success = false;                      // 是否找到有效路径
+    StopReason stopReason = StopReason::None;  // 终止原因
+    std::vector<Square> path;                  // 遍历路径（成功时包含全部格子，起点在首位）
+    long long nodes = 0;                       // 搜索节点数
+    long long tourCount = 0;                   // 找到的路径数（枚举模式下可能多于 1）
+    long long elapsedMs = 0;                   // 计算耗时（ms）
+    bool fromCache = false;                    // 是否由闭合回路缓存旋转得到（未搜索）
+    SearchStats stats;                         // 搜索统计（见 SEARCH_STATS_ENABLED）
+};
+
+#endif // TOURTYPES_H
@@ -0,0 +1,232 @@
+#include "tourvalidator.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "leaper.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define KNIGHTTOUR_VALIDATOR_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KNIGHTTOUR_VALIDATOR_SSE2 1
+#endif
+
+static_assert(sizeof(Square) == 2 * sizeof(int), "SIMD 校验按 (x, y) 两个 int 紧密排列读取路径");
+
+namespace {
+
+bool inBoard(const Square& sq, int width, int height)
+{
+    return sq.x >= 0 && sq.x < width && sq.y >= 0 && sq.y < height;
+}
+
+// 标量检查 [begin, end) 中的格子与走法（SIMD 剩余部分及定位具体出错位置时使用）
+std::size_t scanScalar(const TourValidator& validator, const Square* path, std::size_t begin, std::size_t end,
+                       std::size_t count, TourDefect& defect)
+{
+    // 没有问题时返回 end
+    for (std::size_t i = begin; i < end; i++) {
+        if (!inBoard(path[i], validator.width(), validator.height())) {
+            defect = TourDefect::OutOfBoard;
+            return i;
+        }
+        if (i + 1 < count && !validator.isLeap(path[i], path[i + 1])) {
+            defect = TourDefect::IllegalMove;
+            return i;
+        }
+    }
+    return end;
+}
+
+#if defined(KNIGHTTOUR_VALIDATOR_AVX2)
+
+// 每次检查 4 步：a = path[i..i+3]，b = path[i+1..i+4]，每个 Square 占两个 32 位通道；
+// 步长合法：每个通道的 |d| 为短步长或长步长，且 |dx|+|dy| 为两者之和
+__m256i badLanes(const Square* path, std::size_t i, __m256i limit, __m256i shortStep, __m256i longStep,
+                 __m256i stepSum)
+{
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(path + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(path + i + 1));
+    const __m256i d = _mm256_abs_epi32(_mm256_sub_epi32(b, a));
+    const __m256i sum = _mm256_add_epi32(d, _mm256_shuffle_epi32(d, _MM_SHUFFLE(2, 3, 0, 1))); // |dx|+|dy|
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i stepOk = _mm256_and_si256(_mm256_or_si256(_mm256_cmpeq_epi32(d, shortStep),
+                                                            _mm256_cmpeq_epi32(d, longStep)),
+                                            _mm256_cmpeq_epi32(sum, stepSum));
+    __m256i bad = _mm256_xor_si256(stepOk, _mm256_set1_epi32(-1));
+    // 越界：坐标 < 0 或 >= 上限
+    bad = _mm256_or_si256(bad, _mm256_cmpgt_epi32(zero, a));
+    bad = _mm256_or_si256(bad, _mm256_cmpgt_epi32(a, limit));
+    return bad;
+}
+
+#elif defined(KNIGHTTOUR_VALIDATOR_SSE2)
+
+// 每次检查 2 步（SSE2 没有 abs_epi32，用算术右移求绝对值）
+__m128i badLanes(const Square* path, std::size_t i, __m128i limit, __m128i shortStep, __m128i longStep,
+                 __m128i stepSum)
+{
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(path + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(path + i + 1));
+    const __m128i diff = _mm_sub_epi32(b, a);
+    const __m128i sign = _mm_srai_epi32(diff, 31);
+    const __m128i d = _mm_sub_epi32(_mm_xor_si128(diff, sign), sign);
+    const __m128i sum = _mm_add_epi32(d, _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 3, 0, 1))); // |dx|+|dy|
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i stepOk = _mm_and_si128(_mm_or_si128(_mm_cmpeq_epi32(d, shortStep), _mm_cmpeq_epi32(d, longStep)),
+                                         _mm_cmpeq_epi32(sum, stepSum));
+    __m128i bad = _mm_xor_si128(stepOk, _mm_set1_epi32(-1));
+    // 越界：坐标 < 0 或 >= 上限
+    bad = _mm_or_si128(bad, _mm_cmplt_epi32(a, zero));
+    bad = _mm_or_si128(bad, _mm_cmpgt_epi32(a, limit));
+    return bad;
+}
+
+#endif
+
+// 定位第一个重复访问或经过障碍的格子（只在确认存在冲突后调用）
+std::size_t findRevisit(const Square* path, std::size_t count, int width, const std::vector<std::uint64_t>& blocked,
+                        std::vector<std::uint64_t>& visited, TourDefect& defect)
+{
+    std::copy(blocked.begin(), blocked.end(), visited.begin());
+    for (std::size_t i = 0; i < count; i++) {
+        const std::size_t bit = static_cast<std::size_t>(path[i].y) * width + path[i].x;
+        const std::uint64_t mask = std::uint64_t(1) << (bit % 64);
+        if (visited[bit / 64] & mask) {
+            defect = (blocked[bit / 64] & mask) ? TourDefect::Blocked : TourDefect::Revisited;
+            return i;
+        }
+        visited[bit / 64] |= mask;
+    }
+    return count;
+}
+
+} // namespace
+
+TourValidator::TourValidator(int width, int height, LeaperType leaper, const ObstacleMask& obstacles)
+    : m_width(width)
+    , m_height(height)
+    , m_leaper(leaper)
+    , m_blocked((static_cast<std::size_t>(width > 0 ? width : 0) * (height > 0 ? height : 0) + 63) / 64, 0)
+    , m_visited(m_blocked.size(), 0)
+{
+    // 障碍掩码按列（x * height + y）编号，访问位集合按行编号，这里转换一次
+    m_freeCount = static_cast<std::size_t>(width > 0 ? width : 0) * (height > 0 ? height : 0);
+    if (!obstacles.empty()) {
+        for (int x = 0; x < width; x++) {
+            for (int y = 0; y < height; y++) {
+                if (obstacles.test(x * height + y)) {
+                    const std::size_t bit = static_cast<std::size_t>(y) * width + x;
+                    m_blocked[bit / 64] |= std::uint64_t(1) << (bit % 64);
+                    m_freeCount--;
+                }
+            }
+        }
+    }
+    visitLeaper(leaper, [this](auto piece) {
+        m_shortStep = decltype(piece)::shortStep;
+        m_longStep = decltype(piece)::longStep;
+    });
+}
+
+// 向量部分只判断"有没有问题"，发现问题后回到标量代码定位具体的格子
+std::size_t TourValidator::scanMoves(const Square* path, std::size_t begin, std::size_t end, std::size_t count,
+                                     TourDefect& defect) const
+{
+    std::size_t i = begin;
+#if defined(KNIGHTTOUR_VALIDATOR_AVX2)
+    constexpr std::size_t LANES = 4;
+    const __m256i limit = _mm256_setr_epi32(m_width - 1, m_height - 1, m_width - 1, m_height - 1,
+                                            m_width - 1, m_height - 1, m_width - 1, m_height - 1);
+    const __m256i shortStep = _mm256_set1_epi32(m_shortStep);
+    const __m256i longStep = _mm256_set1_epi32(m_longStep);
+    const __m256i stepSum = _mm256_set1_epi32(m_shortStep + m_longStep);
+    for (; i + LANES <= end && i + LANES < count; i += LANES) {
+        const __m256i bad = badLanes(path, i, limit, shortStep, longStep, stepSum);
+        if (!_mm256_testz_si256(bad, bad)) {
+            return scanScalar(*this, path, i, i + LANES, count, defect);
+        }
+    }
+#elif defined(KNIGHTTOUR_VALIDATOR_SSE2)
+    constexpr std::size_t LANES = 2;
+    const __m128i limit = _mm_setr_epi32(m_width - 1, m_height - 1, m_width - 1, m_height - 1);
+    const __m128i shortStep = _mm_set1_epi32(m_shortStep);
+    const __m128i longStep = _mm_set1_epi32(m_longStep);
+    const __m128i stepSum = _mm_set1_epi32(m_shortStep + m_longStep);
+    for (; i + LANES <= end && i + LANES < count; i += LANES) {
+        if (_mm_movemask_epi8(badLanes(path, i, limit, shortStep, longStep, stepSum)) != 0) {
+            return scanScalar(*this, path, i, i + LANES, count, defect);
+        }
+    }
+#endif
+    return scanScalar(*this, path, i, end, count, defect);
+}
+
+TourCheck TourValidator::validate(const Square* path, std::size_t count, bool closed)
+{
+    TourCheck check;
+    if (m_width <= 0 || m_height <= 0 || count == 0 || count != m_freeCount) {
+        check.defect = TourDefect::WrongLength;
+        return check;
+    }
+
+    // 障碍格子预先标记为已访问：经过障碍与重复访问在第二遍中一起被发现
+    std::memcpy(m_visited.data(), m_blocked.data(), m_visited.size() * sizeof(std::uint64_t));
+    for (std::size_t begin = 0; begin < count; begin += VALIDATE_BLOCK) {
+        const std::size_t end = std::min(begin + VALIDATE_BLOCK, count);
+        const std::size_t bad = scanMoves(path, begin, end, count, check.defect);
+        if (bad < end) {
+            check.index = static_cast<long long>(bad);
+            return check;
+        }
+
+        // 第二遍：本块格子已确认在棋盘内（且仍在缓存中），直接按位检查重复；
+        // 循环内不分支，只累积冲突位，有冲突时再定位具体的格子（很少发生）
+        std::uint64_t collided = 0;
+        for (std::size_t i = begin; i < end; i++) {
+            const std::size_t bit = static_cast<std::size_t>(path[i].y) * m_width + path[i].x;
+            std::uint64_t& word = m_visited[bit / 64];
+            const std::uint64_t mask = std::uint64_t(1) << (bit % 64);
+            collided |= word & mask;
+            word |= mask;
+        }
+        if (collided) {
+            check.index = static_cast<long long>(findRevisit(path, end, m_width, m_blocked, m_visited, check.defect));
+            return check;
+        }
+    }
+
+    if (closed && (count < 2 || !isLeap(path[count - 1], path[0]))) {
+        check.defect = TourDefect::NotClosed;
+        check.index = static_cast<long long>(count - 1);
+    }
+    return check;
+}
+
+std::vector<TourCheck> TourValidator::validateBatch(const std::vector<std::vector<Square>>& tours, bool closed)
+{
+    std::vector<TourCheck> checks;
+    checks.reserve(tours.size());
+    for (const std::vector<Square>& tour : tours) {
+        checks.push_back(validate(tour, closed));
+    }
+    return checks;
+}
+
+std::vector<TourCheck> TourValidator::validateBatch(const std::vector<TourResult>& results, bool closed)
+{
+    std::vector<TourCheck> checks;
+    checks.reserve(results.size());
+    for (const TourResult& result : results) {
+        if (!result.success) {
+            TourCheck failed;
+            failed.defect = TourDefect::WrongLength;
+            checks.push_back(failed);
+        } else {
+            checks.push_back(validate(result.path, closed));
+        }
+    }
+    return checks;
+}
@@ -0,0 +1,140 @@
+#ifndef TOURVALIDATOR_H
+#define TOURVALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "tourtypes.h"
+
+/**
+ * @brief 路径校验失败的原因
+ */
+enum class TourDefect
+{
+    None,          // 有效
+    WrongLength,   // 格子数不等于棋盘上可用（非障碍）的格子数
+    OutOfBoard,    // 格子不在棋盘内
+    Blocked,       // 经过障碍格子
+    IllegalMove,   // 相邻两格不是马步（或指定跳子的一步）
+    Revisited,     // 格子重复访问
+    NotClosed      // 要求闭合回路，但末格不能一步回到首格
+};
+
+/**
+ * @brief 失败原因的文本表示（用于日志与机器可读输出）
+ */
+inline const char* tourDefectName(TourDefect defect)
+{
+    switch (defect) {
+    case TourDefect::None:        return "none";
+    case TourDefect::WrongLength: return "wrong_length";
+    case TourDefect::OutOfBoard:  return "out_of_board";
+    case TourDefect::Blocked:     return "blocked";
+    case TourDefect::IllegalMove: return "illegal_move";
+    case TourDefect::Revisited:   return "revisited";
+    case TourDefect::NotClosed:   return "not_closed";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief 校验结果
+ */
+struct TourCheck
+{
+    TourDefect defect = TourDefect::None;
+    long long index = -1;      // 出错位置：格子下标（走法错误时为该步起点的下标），有效时为 -1
+
+    bool ok() const { return defect == TourDefect::None; }
+};
+
+/**
+ * @brief 巡游路径批量校验（完整性证明：每个非障碍格子恰好一次、每步都是马步（或指定跳子的一步）、闭合时回到起点）
+ * 路径按块（VALIDATE_BLOCK 格）处理，每块在缓存中完成两遍扫描，整条路径只从内存读取一次：
+ *   1. SIMD 同时检查若干相邻格子对：差值取绝对值后 |dx|、|dy| 均为 a 或 b 且 |dx|+|dy|==a+b
+ *      即为 (a, b) 跳子的一步（马为 a=1、b=2），
+ *      同时检查坐标在棋盘内（x86 上用 SSE2，编译时开启 AVX2 则每次 4 步）；
+ *   2. 位集合检查每格只访问一次（可见格子 1 位，校验器内复用，不重复分配）。
+ * 只顺序读取路径，开销接近内存带宽，远小于生成路径的代价。
+ * 不是线程安全的（位集合复用）；多线程校验时每个线程使用一个实例
+ */
+class TourValidator
+{
+public:
+    static constexpr std::size_t VALIDATE_BLOCK = 4096;   // 每块格子数（32KB，两遍扫描都命中 L1/L2）
+
+    /**
+     * @param obstacles 障碍格子（与 TourOptions::obstacles 相同，第 x * height + y 位）；路径须访问其余全部格子
+     */
+    TourValidator(int width, int height, LeaperType leaper = LeaperType::Knight,
+                  const ObstacleMask& obstacles = ObstacleMask());
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    LeaperType leaper() const { return m_leaper; }
+
+    /**
+     * @brief 校验一条完整路径
+     * @param path 路径首格
+     * @param count 格子数
+     * @param closed 是否要求闭合回路
+     */
+    TourCheck validate(const Square* path, std::size_t count, bool closed);
+
+    TourCheck validate(const std::vector<Square>& path, bool closed)
+    {
+        return validate(path.data(), path.size(), closed);
+    }
+
+    /**
+     * @brief 批量校验（结果与 tours 一一对应）
+     */
+    std::vector<TourCheck> validateBatch(const std::vector<std::vector<Square>>& tours, bool closed);
+
+    /**
+     * @brief 批量校验求解结果（未成功的结果记为 WrongLength）
+     */
+    std::vector<TourCheck> validateBatch(const std::vector<TourResult>& results, bool closed);
+
+    /**
+     * @brief 单步检查（标量，供其他模块复用同一判定）
+     */
+    static bool isKnightMove(const Square& from, const Square& to)
+    {
+        const int dx = from.x - to.x;
+        const int dy = from.y - to.y;
+        return dx * dx + dy * dy == 5;
+    }
+
+    /**
+     * @brief 单步检查（按校验器的棋子）
+     */
+    bool isLeap(const Square& from, const Square& to) const
+    {
+        const int dx = std::abs(from.x - to.x);
+        const int dy = std::abs(from.y - to.y);
+        return (dx == m_shortStep && dy == m_longStep) || (dx == m_longStep && dy == m_shortStep);
+    }
+
+private:
+    /**
+     * @brief 第一遍：检查 [begin, end) 中的格子及从它们出发的走法
+     * @param defect 输出：发现的问题类型
+     * @return 第一个越界格子或非法走法的位置（没有时返回 end）
+     */
+    std::size_t scanMoves(const Square* path, std::size_t begin, std::size_t end, std::size_t count,
+                          TourDefect& defect) const;
+
+    int m_width = 0;
+    int m_height = 0;
+    LeaperType m_leaper = LeaperType::Knight;
+    int m_shortStep = 1;                    // 棋子的两个步长（马为 1、2）
+    int m_longStep = 2;
+    std::size_t m_freeCount = 0;            // 非障碍格子数（完整路径的长度）
+    std::vector<std::uint64_t> m_blocked;   // 障碍位集合（与 m_visited 同布局；每次校验以它作为初始访问状态）
+    std::vector<std::uint64_t> m_visited;   // 访问位集合（第 y * width + x 位）
+};
+
+#endif // TOURVALIDATOR_H
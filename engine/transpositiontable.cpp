@@ -0,0 +1,71 @@
+#include "transpositiontable.h"
+
+namespace {
+
+std::uint64_t splitMix64(std::uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+TranspositionTable::TranspositionTable(std::size_t megabytes)
+{
+    const std::size_t buckets = megabytes * 1024 * 1024 / sizeof(Bucket);
+    while (m_bucketCount * 2 <= buckets) {
+        m_bucketCount *= 2;
+    }
+    m_buckets.reset(new Bucket[m_bucketCount]);
+    clear();
+}
+
+// 已有相同键或空槽位时写入该槽位，否则按键的高位替换（新状态优先，旧状态逐渐被淘汰）
+void TranspositionTable::store(std::uint64_t key)
+{
+    key = normalizedKey(key);
+    std::atomic<std::uint64_t>* bucket = bucketFor(key);
+    for (int i = 0; i < BUCKET_SLOTS; i++) {
+        const std::uint64_t current = bucket[i].load(std::memory_order_relaxed);
+        if (current == key) {
+            return;
+        }
+        if (current == 0) {
+            bucket[i].store(key, std::memory_order_relaxed);
+            return;
+        }
+    }
+    bucket[key >> 62].store(key, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+    for (std::size_t i = 0; i < m_bucketCount; i++) {
+        for (std::atomic<std::uint64_t>& slot : m_buckets[i].slots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+    m_hits.store(0, std::memory_order_relaxed);
+    m_misses.store(0, std::memory_order_relaxed);
+    m_stores.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t TranspositionTable::zobristKey(int index, int kind)
+{
+    return splitMix64(static_cast<std::uint64_t>(index) * 2 + static_cast<std::uint64_t>(kind));
+}
+
+std::uint64_t TranspositionTable::searchSalt(int width, int height, bool closed, int startIndex, LeaperType leaper)
+{
+    std::uint64_t salt = splitMix64(0x4B4E5452ULL ^ (static_cast<std::uint64_t>(width) << 32)
+                                    ^ static_cast<std::uint64_t>(height));
+    if (leaper != LeaperType::Knight) {
+        salt = splitMix64(salt ^ (static_cast<std::uint64_t>(leaper) << 56));
+    }
+    if (closed) {
+        salt = splitMix64(salt ^ (static_cast<std::uint64_t>(startIndex) + 1));
+    }
+    return salt;
+}
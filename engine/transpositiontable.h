@@ -0,0 +1,117 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "tourtypes.h"
+
+/**
+ * @brief 已证明无解的搜索状态表（Zobrist 哈希，固定大小，无锁）
+ * 回溯搜索中（当前格子，已访问集合）相同的状态会经由不同的走法顺序重复出现；
+ * 一个状态的子树穷尽而没有找到路径后记入本表，之后再遇到同一状态直接跳过。
+ * 只保存 64 位键（出现即表示"无解"），每 4 个槽位组成一个桶（32 字节，按 32 字节对齐分配，不跨缓存行），
+ * 桶满时按键的高位选择被替换的槽位。读写都是 relaxed 原子操作，多个求解器（线程）可共享一张表；
+ * 哈希冲突的概率约为 状态数 / 2^64，可以忽略
+ * 键由求解器计算（见 zobristKey），不同棋盘尺寸、棋子、闭合要求与起点的状态用不同的盐区分
+ */
+class TranspositionTable
+{
+public:
+    static constexpr int BUCKET_SLOTS = 4;
+
+    /**
+     * @param megabytes 内存大小（MB），按 2 的幂向下取整，至少一个桶
+     */
+    explicit TranspositionTable(std::size_t megabytes = 64);
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /**
+     * @brief 查询状态是否已证明无解
+     */
+    bool contains(std::uint64_t key) const
+    {
+        key = normalizedKey(key);
+        const std::atomic<std::uint64_t>* bucket = bucketFor(key);
+        for (int i = 0; i < BUCKET_SLOTS; i++) {
+            if (bucket[i].load(std::memory_order_relaxed) == key) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 记录无解状态（桶满时替换一个槽位）
+     */
+    void store(std::uint64_t key);
+
+    /**
+     * @brief 清空表与统计
+     */
+    void clear();
+
+    std::size_t slotCount() const { return m_bucketCount * BUCKET_SLOTS; }
+    std::size_t sizeBytes() const { return slotCount() * sizeof(std::uint64_t); }
+
+    /**
+     * @brief 累计命中/未命中/写入次数（求解器在每次搜索结束时汇总一次，不在热路径上更新共享计数）
+     */
+    void addCounts(long long hits, long long misses, long long stores)
+    {
+        m_hits.fetch_add(hits, std::memory_order_relaxed);
+        m_misses.fetch_add(misses, std::memory_order_relaxed);
+        m_stores.fetch_add(stores, std::memory_order_relaxed);
+    }
+
+    long long hits() const { return m_hits.load(std::memory_order_relaxed); }
+    long long misses() const { return m_misses.load(std::memory_order_relaxed); }
+    long long stores() const { return m_stores.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zobrist 随机数：第 index 个格子的第 kind 类键（0=已访问，1=当前所在）
+     * 由格子下标确定性地生成（splitmix64），所有求解器得到相同的键，因此可以共享一张表
+     */
+    static std::uint64_t zobristKey(int index, int kind);
+
+    /**
+     * @brief 搜索条件的盐（棋盘尺寸、棋子、是否闭合；闭合回路还与起点有关）
+     */
+    static std::uint64_t searchSalt(int width, int height, bool closed, int startIndex,
+                                    LeaperType leaper = LeaperType::Knight);
+
+private:
+    // 0 表示空槽位
+    static std::uint64_t normalizedKey(std::uint64_t key) { return key != 0 ? key : 1; }
+
+    /**
+     * @brief 桶：对齐到自身大小，一次查询只访问一条缓存行（C++17 按 alignas 选择对齐的 operator new[]）
+     */
+    struct alignas(BUCKET_SLOTS * sizeof(std::uint64_t)) Bucket
+    {
+        std::atomic<std::uint64_t> slots[BUCKET_SLOTS];
+    };
+    static_assert(sizeof(Bucket) == BUCKET_SLOTS * sizeof(std::uint64_t), "桶内没有填充");
+
+    const std::atomic<std::uint64_t>* bucketFor(std::uint64_t key) const
+    {
+        return m_buckets[key & (m_bucketCount - 1)].slots;
+    }
+
+    std::atomic<std::uint64_t>* bucketFor(std::uint64_t key)
+    {
+        return m_buckets[key & (m_bucketCount - 1)].slots;
+    }
+
+    std::size_t m_bucketCount = 1;
+    std::unique_ptr<Bucket[]> m_buckets;
+    std::atomic<long long> m_hits{0};
+    std::atomic<long long> m_misses{0};
+    std::atomic<long long> m_stores{0};
+};
+
+#endif // TRANSPOSITIONTABLE_H
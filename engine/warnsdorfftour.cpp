@@ -0,0 +1,307 @@
+#include "warnsdorfftour.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <tuple>
+
+#include "leaper.h"
+
+namespace {
+
+// 选择键（按字典序比较，越小越优先）：最后一格不能接上锚点（闭合回路时）、剩余度数、
+// 辅助规则的排序值、坐标序号（或打乱后的序号）。各字段按完整宽度比较，不限制棋盘边长
+struct ChoiceKey
+{
+    bool cannotReturn;
+    int degree;
+    std::uint64_t secondary;
+    int tieRank;
+
+    bool operator<(const ChoiceKey& other) const
+    {
+        return std::tie(cannotReturn, degree, secondary, tieRank)
+               < std::tie(other.cannotReturn, other.degree, other.secondary, other.tieRank);
+    }
+};
+
+// 固定走法优先级（按 MOVE_DIRECTIONS 下标，数值越小越优先）：
+// 方向顺序 (2,1) (1,2) (-1,2) (2,-1) (-2,1) (-2,-1) (1,-2) (-1,-2)，
+// 在 5x5~64x64 开放路径上逐一比较全部 8! 种顺序得到（成功率最高的一种）
+constexpr unsigned FIXED_ORDER_RANK[MOVE_COUNT] = {0, 1, 2, 4, 5, 7, 6, 3};
+
+// Pohl 规则向前模拟的层数；每层的结果占 4 位（度数不超过 8，NO_SUCCESSOR 表示模拟路径走入死路）
+constexpr int POHL_DEPTH = 3;
+constexpr std::uint64_t NO_SUCCESSOR = 15;
+
+} // namespace
+
+WarnsdorffTour::WarnsdorffTour(const TourOptions& options, TieBreak tieBreak)
+    : m_options(options)
+    , m_tieBreak(tieBreak)
+{
+}
+
+TourResult WarnsdorffTour::solve(const Square& start, const std::atomic<bool>* cancelFlag)
+{
+    return visitLeaper(m_options.leaper, [this, &start, cancelFlag](auto piece) {
+        return solveWith<decltype(piece)>(start, cancelFlag);
+    });
+}
+
+// 单遍构造：每步只前进，不保存候选列表
+template <class Piece>
+TourResult WarnsdorffTour::solveWith(const Square& start, const std::atomic<bool>* cancelFlag)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    TourResult result;
+    if (!inBoard(start.x, start.y) || m_options.obstacles.test(indexOf(start.x, start.y))) {
+        return result;
+    }
+
+    const int total = m_options.squareCount();
+    buildCells<Piece>();
+    if (m_options.tieBreakSeed != 0) {
+        m_tieRank.resize(m_options.width * m_options.height);
+        std::iota(m_tieRank.begin(), m_tieRank.end(), 0);
+        std::mt19937 rng(m_options.tieBreakSeed);
+        std::shuffle(m_tieRank.begin(), m_tieRank.end(), rng);
+    } else {
+        m_tieRank.clear();
+    }
+
+    // 闭合回路的尾部从起点倒着预留：锚点（起初为起点）只剩一个未访问邻居时，该邻居即为回路中
+    // 锚点的前一格，立即预留并成为新的锚点；路径的最后一格必须与锚点相邻
+    m_anchor = start;
+    m_anchorExits = m_cells[cellOf(start.x, start.y)];
+    m_reserved.clear();
+    std::vector<Square> path;
+    path.reserve(total);
+    int remaining = total;
+    Square sq = start;
+    for (int step = 1;; step++) {
+        visit<Piece>(sq);
+        path.push_back(sq);
+        remaining--;
+        if (m_options.closed && !reserveTail<Piece>(remaining)) {
+            break;
+        }
+        result.nodes = static_cast<long long>(path.size() + m_reserved.size());
+        if (remaining == 0) {
+            break;
+        }
+        if (cancelFlag && step % DEFAULT_BUDGET_CHECK_INTERVAL == 0 && cancelFlag->load(std::memory_order_relaxed)) {
+            result.stopReason = StopReason::Cancelled;
+            result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - begin).count();
+            return result;
+        }
+        if (!chooseNext<Piece>(sq, m_options.closed && remaining == 1)) {
+            break;
+        }
+    }
+
+    path.insert(path.end(), m_reserved.rbegin(), m_reserved.rend());
+    bool complete = static_cast<int>(path.size()) == total;
+    if (complete && m_options.closed) {
+        complete = Piece::isMove(path.back().x - start.x, path.back().y - start.y);
+    }
+    result.success = complete;
+    result.stopReason = complete ? StopReason::Solved : StopReason::DeadEnd;
+    result.tourCount = complete ? 1 : 0;
+    if (complete) {
+        result.path = std::move(path);
+    }
+    result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - begin).count();
+    return result;
+}
+
+// 访问格子：未访问邻居的剩余度数减一（填充格与已访问格同为 BLOCKED_CELL，不需要边界检查）
+template <class Piece>
+void WarnsdorffTour::visit(const Square& sq)
+{
+    unsigned char* const cell = &m_cells[cellOf(sq.x, sq.y)];
+    *cell = BLOCKED_CELL;
+    forEachLeap<Piece>([&](auto dir) {
+        unsigned char& neighbor = cell[m_offsets[decltype(dir)::value]];
+        if (neighbor != BLOCKED_CELL) {
+            neighbor--;
+        }
+    });
+    if (Piece::isMove(sq.x - m_anchor.x, sq.y - m_anchor.y)) {
+        m_anchorExits--;
+    }
+}
+
+template <class Piece>
+bool WarnsdorffTour::reserveTail(int& remaining)
+{
+    while (m_anchorExits == 1 && remaining > 1) {
+        const unsigned char* const cell = &m_cells[cellOf(m_anchor.x, m_anchor.y)];
+        Square exit;
+        forEachLeap<Piece>([&](auto i) {
+            constexpr int dir = decltype(i)::value;
+            if (cell[m_offsets[dir]] != BLOCKED_CELL) {
+                exit = Square(m_anchor.x + Piece::directions[dir].dx, m_anchor.y + Piece::directions[dir].dy);
+            }
+        });
+        m_reserved.push_back(exit);
+        m_anchor = exit;
+        m_anchorExits = m_cells[cellOf(exit.x, exit.y)];
+        visit<Piece>(exit);
+        remaining--;
+    }
+    return m_anchorExits > 0 || remaining == 0;
+}
+
+// 逐个比较候选的选择键（全程用坐标计算，不做除法；方向位移为编译期常量）
+template <class Piece>
+bool WarnsdorffTour::chooseNext(Square& sq, bool isFinalStep) const
+{
+    Square best;
+    ChoiceKey bestKey = {};
+    bool found = false;
+    const unsigned char* const cell = &m_cells[cellOf(sq.x, sq.y)];
+    forEachLeap<Piece>([&](auto i) {
+        constexpr int dir = decltype(i)::value;
+        const unsigned char degree = cell[m_offsets[dir]];
+        if (degree == BLOCKED_CELL) {
+            return;
+        }
+        const int nx = sq.x + Piece::directions[dir].dx;
+        const int ny = sq.y + Piece::directions[dir].dy;
+        const bool cannotReturn = isFinalStep && !Piece::isMove(nx - m_anchor.x, ny - m_anchor.y);
+        const int tieRank = m_tieRank.empty() ? indexOf(nx, ny) : m_tieRank[indexOf(nx, ny)];
+        const ChoiceKey key = {cannotReturn, degree, secondaryKey<Piece>(nx, ny, dir), tieRank};
+        if (!found || key < bestKey) {
+            best = Square(nx, ny);
+            bestKey = key;
+            found = true;
+        }
+    });
+    if (!found) {
+        return false;
+    }
+    sq = best;
+    return true;
+}
+
+template <class Piece>
+std::uint64_t WarnsdorffTour::secondaryKey(int x, int y, int dir) const
+{
+    switch (m_tieBreak) {
+    case TieBreak::Index:
+        return 0;
+    case TieBreak::Pohl:
+        return pohlKey<Piece>(x, y);
+    case TieBreak::FixedOrder:
+        return FIXED_ORDER_RANK[dir];
+    case TieBreak::Roth: {
+        // 到中心距离的平方（坐标加倍避免小数，64 位计算避免大棋盘溢出），越远越优先
+        const std::uint64_t dx = static_cast<std::uint64_t>(std::llabs(2LL * x - (m_options.width - 1)));
+        const std::uint64_t dy = static_cast<std::uint64_t>(std::llabs(2LL * y - (m_options.height - 1)));
+        const std::uint64_t maxDx = static_cast<std::uint64_t>(m_options.width - 1);
+        const std::uint64_t maxDy = static_cast<std::uint64_t>(m_options.height - 1);
+        return maxDx * maxDx + maxDy * maxDy - (dx * dx + dy * dy);
+    }
+    }
+    return 0;
+}
+
+// 假设走到 (x, y)，再按 Warnsdorff 规则（同度数取坐标序号较小者）向前模拟 POHL_DEPTH 步，
+// 依次记录每步所选格子的剩余度数；模拟中访问的格子不写回数组，
+// 其对邻居度数的影响按相邻关系现算（模拟路径最多 POHL_DEPTH 格）
+template <class Piece>
+std::uint64_t WarnsdorffTour::pohlKey(int x, int y) const
+{
+    Square visited[POHL_DEPTH] = {Square(x, y)};
+    std::uint64_t key = 0;
+    for (int level = 0; level < POHL_DEPTH; level++) {
+        const Square from = visited[level];
+        const unsigned char* const cell = &m_cells[cellOf(from.x, from.y)];
+        Square best;
+        std::uint64_t bestDegree = NO_SUCCESSOR;
+        forEachLeap<Piece>([&](auto i) {
+            constexpr int dir = decltype(i)::value;
+            const unsigned char stored = cell[m_offsets[dir]];
+            if (stored == BLOCKED_CELL) {
+                return;
+            }
+            const Square next(from.x + Piece::directions[dir].dx, from.y + Piece::directions[dir].dy);
+            int degree = stored;
+            for (int j = 0; j <= level; j++) {
+                if (visited[j] == next) {
+                    return;
+                }
+                degree -= Piece::isMove(next.x - visited[j].x, next.y - visited[j].y);
+            }
+            const std::uint64_t value = static_cast<std::uint64_t>(degree);
+            if (value < bestDegree || (value == bestDegree && indexOf(next.x, next.y) < indexOf(best.x, best.y))) {
+                best = next;
+                bestDegree = value;
+            }
+        });
+        key = key << 4 | bestDegree;
+        if (bestDegree == NO_SUCCESSOR) {
+            key <<= 4 * (POHL_DEPTH - 1 - level);
+            break;
+        }
+        if (level + 1 < POHL_DEPTH) {
+            visited[level + 1] = best;
+        }
+    }
+    return key;
+}
+
+// 填充格初始化为 BLOCKED_CELL；离边缘至少 Piece::reach 格的格子度数为 8，其余逐个计算；
+// 障碍格子最后按"已访问"处理：置为 BLOCKED_CELL 并使其邻居的度数减一
+template <class Piece>
+void WarnsdorffTour::buildCells()
+{
+    constexpr int PADDING = Piece::reach;
+    const int width = m_options.width;
+    const int height = m_options.height;
+    m_padding = PADDING;
+    m_stride = height + 2 * PADDING;
+    for (int dir = 0; dir < MOVE_COUNT; dir++) {
+        m_offsets[dir] = Piece::directions[dir].dx * m_stride + Piece::directions[dir].dy;
+    }
+    m_cells.assign(static_cast<size_t>(width + 2 * PADDING) * m_stride, BLOCKED_CELL);
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+            if (x >= PADDING && x < width - PADDING && y == PADDING && height > 2 * PADDING) {
+                std::fill_n(&m_cells[cellOf(x, y)], height - 2 * PADDING, MOVE_COUNT);
+                y = height - PADDING - 1;
+                continue;
+            }
+            int count = 0;
+            forEachLeap<Piece>([&](auto i) {
+                constexpr MoveDelta dir = Piece::directions[decltype(i)::value];
+                count += inBoard(x + dir.dx, y + dir.dy);
+            });
+            m_cells[cellOf(x, y)] = static_cast<unsigned char>(count);
+        }
+    }
+
+    if (m_options.obstacles.empty()) {
+        return;
+    }
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+            if (!m_options.obstacles.test(indexOf(x, y))) {
+                continue;
+            }
+            unsigned char* const cell = &m_cells[cellOf(x, y)];
+            *cell = BLOCKED_CELL;
+            forEachLeap<Piece>([&](auto dir) {
+                unsigned char& neighbor = cell[m_offsets[decltype(dir)::value]];
+                if (neighbor != BLOCKED_CELL) {
+                    neighbor--;
+                }
+            });
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#ifndef WARNSDORFFTOUR_H
+#define WARNSDORFFTOUR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tourtypes.h"
+
+/**
+ * @brief Warnsdorff 同度数候选的辅助规则
+ */
+enum class TieBreak
+{
+    Index,          // 坐标序号（与 KnightTourSolver 默认顺序一致）
+    Pohl,           // Pohl：对同度数候选递归应用 Warnsdorff 规则（模拟走入后比较后继的最小度数，逐层向前）
+    FixedOrder,     // 固定的走法方向优先级（离线比较 8! 种顺序得到；不是 Squirrel–Cull 按尺寸与步数切换的走法表）
+    Roth            // Arnd Roth：取离棋盘中心最远者
+};
+
+/**
+ * @brief 辅助规则的文本表示（用于日志与机器可读输出）
+ */
+inline const char* tieBreakName(TieBreak tieBreak)
+{
+    switch (tieBreak) {
+    case TieBreak::Index:        return "index";
+    case TieBreak::Pohl:         return "pohl";
+    case TieBreak::FixedOrder:   return "fixed_order";
+    case TieBreak::Roth:         return "roth";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief 无回溯的 Warnsdorff 单遍构造
+ * 每一步走向剩余度数最小的格子，同度数时依次按辅助规则、坐标序号（或 tieBreakSeed 打乱的序号）选择，
+ * 棋子由 options.leaper 指定（各跳子的走法循环在编译期展开），
+ * 从不撤销：每步 O(8)（Pohl 规则 O(8 × 8 × 3)），整条路径 O(N²)，大棋盘上耗时与格子数成正比。
+ * 闭合回路从起点倒着预留尾部：锚点只剩一个未访问邻居时把它预留为回路的前一格，路径最后接上预留的格子。
+ * 走入死路（没有未访问的邻居、锚点被孤立，或闭合回路时末格不能接上锚点）即以 DeadEnd 结束，
+ * 调用方据此回退到完整搜索（KnightTourSolver / PortfolioSolver）
+ */
+class WarnsdorffTour
+{
+public:
+    explicit WarnsdorffTour(const TourOptions& options = TourOptions(), TieBreak tieBreak = TieBreak::Roth);
+
+    const TourOptions& options() const { return m_options; }
+    void setOptions(const TourOptions& options) { m_options = options; }
+
+    TieBreak tieBreak() const { return m_tieBreak; }
+    void setTieBreak(TieBreak tieBreak) { m_tieBreak = tieBreak; }
+
+    /**
+     * @brief 从 start 出发单遍构造路径
+     * @param cancelFlag 外部取消标志（可为空），每 DEFAULT_BUDGET_CHECK_INTERVAL 格检查一次
+     * @return 成功时 stopReason 为 Solved、path 为完整路径；走入死路时为 DeadEnd（path 为空），
+     *         nodes 为到达的路径长度；被取消时为 Cancelled；起点无效时为 None
+     */
+    TourResult solve(const Square& start, const std::atomic<bool>* cancelFlag = nullptr);
+
+private:
+    /**
+     * @brief 按编译期跳子构造（solve 按 options.leaper 分派到对应实例）
+     */
+    template <class Piece>
+    TourResult solveWith(const Square& start, const std::atomic<bool>* cancelFlag);
+
+    /**
+     * @brief 把 sq 标记为已访问：邻居的剩余度数减一，与锚点相邻时锚点的出口数减一
+     */
+    template <class Piece>
+    void visit(const Square& sq);
+
+    /**
+     * @brief 锚点只剩一个出口时依次预留（闭合回路），remaining 为尚未访问也未预留的格子数
+     * @return 锚点被孤立（没有出口且还有格子未访问）时返回 false
+     */
+    template <class Piece>
+    bool reserveTail(int& remaining);
+
+    /**
+     * @brief 选择 sq 之后的下一格，成功时写回 sq（没有候选时返回 false）
+     * @param isFinalStep 是否为闭合回路路径部分的最后一格（必须与锚点相邻）
+     */
+    template <class Piece>
+    bool chooseNext(Square& sq, bool isFinalStep) const;
+
+    /**
+     * @brief 候选格子 (x, y) 的辅助规则排序值（越小越优先），dir 为走到该格的方向下标
+     */
+    template <class Piece>
+    std::uint64_t secondaryKey(int x, int y, int dir) const;
+
+    /**
+     * @brief Pohl 规则的排序值：走到 (x, y) 后按 Warnsdorff 规则模拟的各步度数（逐层比较）
+     */
+    template <class Piece>
+    std::uint64_t pohlKey(int x, int y) const;
+
+    /**
+     * @brief 初始化带填充的格子数组（每个格子一个字节：剩余度数或 BLOCKED_CELL）与各方向的下标偏移
+     */
+    template <class Piece>
+    void buildCells();
+
+    int indexOf(int x, int y) const { return x * m_options.height + y; }
+
+    /**
+     * @brief 格子在填充数组中的下标（四周各留 m_padding 格）
+     */
+    size_t cellOf(int x, int y) const
+    {
+        return static_cast<size_t>(x + m_padding) * m_stride + (y + m_padding);
+    }
+
+    bool inBoard(int x, int y) const
+    {
+        return x >= 0 && x < m_options.width && y >= 0 && y < m_options.height;
+    }
+
+    TourOptions m_options;
+    TieBreak m_tieBreak = TieBreak::Roth;
+    Square m_anchor;                                   // 闭合回路尾部的锚点（起点或最后预留的格子）
+    int m_anchorExits = 0;                             // 锚点的未访问邻居数
+    std::vector<Square> m_reserved;                    // 按预留顺序排列的尾部格子（与起点相邻者在前）
+    static constexpr unsigned char BLOCKED_CELL = 0xFF; // 已访问、障碍格子或棋盘外
+
+    std::vector<unsigned char> m_cells;    // 未访问格子的剩余度数（增量维护），其余为 BLOCKED_CELL
+    int m_padding = 2;                     // 四周的填充宽度（棋子一步最远跨越的格数，马为 2）
+    int m_stride = 0;                      // 填充数组的列长度（height + 2 * m_padding）
+    int m_offsets[MOVE_COUNT] = {};        // 各走法方向在填充数组中的下标偏移
+    std::vector<int> m_tieRank;            // 最终的同键排序序号（仅 tieBreakSeed 非零时使用）
+};
+
+#endif // WARNSDORFFTOUR_H
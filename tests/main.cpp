@@ -0,0 +1,29 @@
+#include <cstdio>
+
+#include "testsupport.h"
+
+// 引擎自检：每组检查与独立实现（暴力枚举）或已知结论对照，
+// 失败时输出位置与说明，全部通过时返回 0（供 CI 或手动运行）
+
+int main()
+{
+    std::setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    testEngine();
+    testCancellation();
+    testBitboard();
+    testSearchBudget();
+    testPortfolio();
+    testParallelTreeSearch();
+    testTourCache();
+    testStructuredTour();
+    testEnumeration();
+    testTourFile();
+    testValidator();
+    testWarnsdorff();
+    testTranspositionTable();
+    testFeasibility();
+
+    std::printf("%d checks, %d failed\n", checkCount(), failureCount());
+    return failureCount() == 0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#include "knighttoursolver.h"
+#include "testsupport.h"
+
+// 位棋盘快速路径：每个不超过 8x8 的尺寸、每个起点，与通用路径的搜索结果逐节点一致
+// （两条路径的格子编号保持同样的相对顺序，候选顺序相同，节点数与路径都应完全相同）
+void testBitboard()
+{
+    SearchBudget budget;
+    budget.timeLimitMs = 0;
+    budget.maxNodes = 20000; // 节点上限精确生效，超出上限的起点也能逐节点比较
+
+    int mismatched = 0;
+    int compared = 0;
+    for (int width = 1; width <= 8; width++) {
+        for (int height = 1; height <= 8; height++) {
+            for (bool closed : {true, false}) {
+                TourOptions options;
+                options.width = width;
+                options.height = height;
+                options.closed = closed;
+                KnightTourSolver fast(options);
+                options.bitboard = false;
+                KnightTourSolver generic(options);
+
+                for (int x = 0; x < width; x++) {
+                    for (int y = 0; y < height; y++) {
+                        const TourResult a = fast.solve(Square(x, y), budget);
+                        const TourResult b = generic.solve(Square(x, y), budget);
+                        compared++;
+                        if (a.stopReason != b.stopReason || a.nodes != b.nodes || a.path != b.path) {
+                            mismatched++;
+                            check(false, "bitboard",
+                                  sizeName(width, height) + (closed ? " closed" : " open") + " from "
+                                      + std::to_string(x) + "," + std::to_string(y) + ": "
+                                      + stopReasonName(a.stopReason) + "/" + std::to_string(a.nodes) + " vs "
+                                      + stopReasonName(b.stopReason) + "/" + std::to_string(b.nodes));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    check(mismatched == 0, "bitboard",
+          std::to_string(mismatched) + " of " + std::to_string(compared) + " starts differ");
+
+    // 全部路径计数：同一起点的枚举结果一致
+    for (const Square& size : {Square(5, 5), Square(5, 6), Square(4, 7), Square(6, 6)}) {
+        for (bool closed : {true, false}) {
+            if (!closed && size.x * size.y >= 36) {
+                continue; // 6x6 开放路径数量太多
+            }
+            TourOptions options;
+            options.width = size.x;
+            options.height = size.y;
+            options.closed = closed;
+            const std::vector<Square> prefix = {Square(0, 0)};
+            const TourCallback count = [](const std::vector<Square>&) { return true; };
+            const TourResult a = KnightTourSolver(options).enumerateFrom(prefix, count);
+            options.bitboard = false;
+            const TourResult b = KnightTourSolver(options).enumerateFrom(prefix, count);
+            check(a.stopReason == StopReason::Exhausted && a.tourCount == b.tourCount && a.nodes == b.nodes, "bitboard",
+                  sizeName(size.x, size.y) + (closed ? " closed" : " open") + " enumeration: "
+                      + std::to_string(a.tourCount) + " vs " + std::to_string(b.tourCount));
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "knighttoursolver.h"
+#include "portfoliosolver.h"
+#include "structuredtour.h"
+#include "testsupport.h"
+#include "tourenumerator.h"
+#include "warnsdorfftour.h"
+
+namespace {
+
+// 在另一个线程中延迟设置取消标志，返回从开始到 run 返回的毫秒数
+template <typename Run>
+double cancelAfter(std::atomic<bool>& flag, int delayMs, Run&& run)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    std::thread canceller([&flag, delayMs]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+        flag.store(true, std::memory_order_relaxed);
+    });
+    run();
+    canceller.join();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+// 取消：每个求解阶段都检查取消标志并以 Cancelled 返回（界面在新的点击/改尺寸时依赖这一点）
+void testCancellation()
+{
+    // 6x6 上从角出发的开放路径有数十亿条，不取消时枚举不会在测试时间内结束
+    TourOptions open;
+    open.width = 6;
+    open.height = 6;
+    open.closed = false;
+    SearchBudget unlimited;
+    unlimited.timeLimitMs = 0;
+
+    std::atomic<bool> flag(false);
+    unlimited.cancelFlag = &flag;
+    TourResult result;
+    double elapsedMs = cancelAfter(flag, 50, [&]() {
+        result = KnightTourSolver(open).enumerateFrom({Square(0, 0)}, [](const std::vector<Square>&) { return true; },
+                                                      unlimited);
+    });
+    check(result.stopReason == StopReason::Cancelled, "cancellation",
+          std::string("solver enumeration stopped as ") + stopReasonName(result.stopReason));
+    check(elapsedMs < 2000, "cancellation", "solver enumeration took " + std::to_string(elapsedMs) + "ms to stop");
+
+    flag.store(false);
+    elapsedMs = cancelAfter(flag, 50, [&]() {
+        result = TourEnumerator(open).enumerateFrom(Square(0, 0), TourCallback(), unlimited);
+    });
+    check(result.stopReason == StopReason::Cancelled, "cancellation",
+          std::string("parallel enumeration stopped as ") + stopReasonName(result.stopReason));
+    check(elapsedMs < 2000, "cancellation", "parallel enumeration took " + std::to_string(elapsedMs) + "ms to stop");
+
+    // 已取消的标志：搜索在第一个检查点返回
+    flag.store(true);
+    SearchBudget cancelled = unlimited;
+    cancelled.checkInterval = 1;
+    TourOptions closed;
+    closed.width = 12;
+    closed.height = 12;
+    result = KnightTourSolver(closed).solve(Square(0, 0), cancelled);
+    check(result.stopReason == StopReason::Cancelled && !result.success, "cancellation",
+          std::string("solver with a set flag: ") + stopReasonName(result.stopReason));
+    result = PortfolioSolver(closed).solve(Square(0, 0), cancelled);
+    check(result.stopReason == StopReason::Cancelled && !result.success, "cancellation",
+          std::string("portfolio with a set flag: ") + stopReasonName(result.stopReason));
+
+    // 构造阶段：每 DEFAULT_BUDGET_CHECK_INTERVAL 格检查一次，超过一个间隔的棋盘必须被取消
+    closed.width = 100;
+    closed.height = 100;
+    result = StructuredTour(100, 100).solve(Square(0, 0), &flag);
+    check(result.stopReason == StopReason::Cancelled && !result.success && result.path.empty(), "cancellation",
+          std::string("structured tour with a set flag: ") + stopReasonName(result.stopReason));
+    result = WarnsdorffTour(closed, TieBreak::Roth).solve(Square(0, 0), &flag);
+    check(result.stopReason == StopReason::Cancelled && !result.success && result.path.empty(), "cancellation",
+          std::string("warnsdorff with a set flag: ") + stopReasonName(result.stopReason));
+
+    flag.store(false);
+    check(StructuredTour(100, 100).solve(Square(0, 0), &flag).success, "cancellation",
+          "structured tour fails with a clear flag");
+    check(WarnsdorffTour(closed, TieBreak::Roth).solve(Square(0, 0), &flag).stopReason != StopReason::Cancelled,
+          "cancellation", "warnsdorff cancelled with a clear flag");
+}
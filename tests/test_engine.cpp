@@ -0,0 +1,40 @@
+#include "knighttoursolver.h"
+#include "testsupport.h"
+#include "tourvalidator.h"
+
+// 无界面引擎：不依赖 Qt 即可求解，结果是以起点开头的有效路径；无效起点不报告成功
+void testEngine()
+{
+    struct Case
+    {
+        int width;
+        int height;
+        bool closed;
+        Square start;
+    };
+    const Case cases[] = {
+        {5, 5, false, Square(0, 0)},
+        {6, 6, true, Square(2, 3)},
+        {8, 8, true, Square(0, 0)},
+        {7, 9, false, Square(2, 4)},
+        {10, 10, true, Square(9, 0)},
+    };
+    for (const Case& item : cases) {
+        TourOptions options;
+        options.width = item.width;
+        options.height = item.height;
+        options.closed = item.closed;
+        const std::string name = sizeName(item.width, item.height) + (item.closed ? " closed" : " open");
+        const TourResult result = KnightTourSolver(options).solve(item.start);
+        check(result.success && result.stopReason == StopReason::Solved, "engine", name + ": not solved");
+        check(!result.path.empty() && result.path.front() == item.start, "engine", name + ": wrong start");
+        check(TourValidator(item.width, item.height).validate(result.path, item.closed).ok(), "engine",
+              name + ": invalid tour");
+    }
+
+    TourOptions options;
+    options.width = 8;
+    options.height = 8;
+    const TourResult outside = KnightTourSolver(options).solve(Square(8, 0));
+    check(!outside.success && outside.path.empty(), "engine", "start outside the board reported as solved");
+}
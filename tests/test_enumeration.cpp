@@ -0,0 +1,110 @@
+#include "testsupport.h"
+#include "tourenumerator.h"
+#include "tourvalidator.h"
+
+// 枚举计数：对称约简开启/关闭都须与暴力枚举一致（有障碍时同样如此），逐条输出的路径都须通过校验
+void testEnumeration()
+{
+    struct Case
+    {
+        int width;
+        int height;
+        bool closed;
+        std::vector<Square> obstacles;
+        LeaperType leaper = LeaperType::Knight;
+    };
+    const Case cases[] = {
+        {5, 5, false, {}},
+        {3, 4, false, {}},
+        {4, 5, false, {}},
+        {3, 7, false, {}},
+        {4, 6, false, {}},
+        {4, 6, true, {}},
+        // 有障碍的布局都有路径（1440、80、360、352 条），后两个布局自身对称，对称约简仍然适用
+        {5, 5, false, {Square(0, 0)}},
+        {3, 7, false, {Square(1, 1)}},
+        {4, 5, false, {Square(0, 0), Square(3, 4)}},
+        {3, 8, false, {Square(1, 0), Square(1, 7)}},
+        // 其他跳子在小棋盘上挡住走不到的格子后才有路径：骆驼 4x6 24 条、6x6 1008 条，长颈鹿 5x5 32 条
+        {4, 6, false, {}, LeaperType::Camel},
+        {6, 6, false, {}, LeaperType::Camel},
+        {5, 5, false, {}, LeaperType::Giraffe},
+    };
+
+    for (const Case& item : cases) {
+        TourOptions options;
+        options.width = item.width;
+        options.height = item.height;
+        options.closed = item.closed;
+        options.leaper = item.leaper;
+        if (item.leaper != LeaperType::Knight) {
+            options.obstacles = leaperObstacles(item.width, item.height, item.leaper);
+        }
+        for (const Square& sq : item.obstacles) {
+            options.obstacles.set(sq.x * item.height + sq.y);
+        }
+        const std::string name = sizeName(item.width, item.height) + " " + leaperName(item.leaper)
+                                 + (item.closed ? " closed" : " open")
+                                 + (item.obstacles.empty() ? "" : " with obstacles");
+        const long long expected = bruteForceBoardCount(options);
+
+        for (bool useSymmetry : {true, false}) {
+            TourEnumerator enumerator(options);
+            enumerator.setUseSymmetry(useSymmetry);
+            TourValidator validator(item.width, item.height, item.leaper, options.obstacles);
+            long long invalid = 0;
+            const TourResult result = enumerator.enumerateBoard([&](const std::vector<Square>& path) {
+                invalid += !validator.validate(path, item.closed).ok();
+                return true;
+            });
+            const std::string label = name + (useSymmetry ? " (symmetry)" : " (plain)");
+            check(result.stopReason == StopReason::Exhausted, "enumeration", label + ": not exhausted");
+            check(result.tourCount == expected, "enumeration",
+                  label + ": " + std::to_string(result.tourCount) + " tours, expected " + std::to_string(expected));
+            check(invalid == 0, "enumeration", label + ": " + std::to_string(invalid) + " invalid tours");
+        }
+    }
+
+    // 已知结论（暴力枚举太慢的规模）：5x5 从角上出发的开放路径 304 条，5x6 4542 条，4x7 1682 条；
+    // 5x6 有 8 条无向闭合回路（30 个起点 × 2 个方向 = 480 条有向路径），6x6 有 9862 条（每个起点 19724 条）
+    struct Known
+    {
+        int width;
+        int height;
+        bool closed;
+        bool wholeBoard;
+        long long tours;
+    };
+    const Known known[] = {
+        {5, 5, false, false, 304},
+        {5, 6, false, false, 4542},
+        {4, 7, false, false, 1682},
+        {5, 6, true, true, 480},
+        {6, 6, true, false, 19724},
+    };
+    for (const Known& item : known) {
+        TourOptions options;
+        options.width = item.width;
+        options.height = item.height;
+        options.closed = item.closed;
+        TourEnumerator enumerator(options);
+        const TourResult result =
+            item.wholeBoard ? enumerator.enumerateBoard() : enumerator.enumerateFrom(Square(0, 0));
+        const std::string name = sizeName(item.width, item.height) + (item.closed ? " closed" : " open")
+                                 + (item.wholeBoard ? "" : " corner");
+        check(result.stopReason == StopReason::Exhausted && result.tourCount == item.tours, "enumeration",
+              name + ": " + std::to_string(result.tourCount) + " tours, expected " + std::to_string(item.tours));
+    }
+
+    // 回调返回 false 时停止，已计入的路径数为回调次数
+    TourOptions options;
+    options.width = 5;
+    options.height = 5;
+    options.closed = false;
+    long long calls = 0;
+    const TourResult stopped = TourEnumerator(options).enumerateFrom(Square(0, 0), [&](const std::vector<Square>&) {
+        return ++calls < 10;
+    });
+    check(calls == 10 && stopped.tourCount == 10 && stopped.stopReason != StopReason::Exhausted, "enumeration",
+          "callback stop: " + std::to_string(stopped.tourCount) + " tours after " + std::to_string(calls) + " calls");
+}
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "knighttoursolver.h"
+#include "testsupport.h"
+#include "tourfeasibility.h"
+#include "tourvalidator.h"
+
+// 可行性预检查：每种原因各有一个确定的布局；预检查判定无解的情况搜索也必须无解；
+// Schwenk 定理与公式、与不经预检查的搜索结果一致
+void testFeasibility()
+{
+    // Schwenk：m ≤ n，m、n 都是奇数，或 m = 1、2、4，或 m = 3 且 n = 4、6、8 时无闭合回路
+    for (int width = 1; width <= 12; width++) {
+        for (int height = 1; height <= 12; height++) {
+            const int m = std::min(width, height);
+            const int n = std::max(width, height);
+            const bool expected = !((m % 2 == 1 && n % 2 == 1) || m == 1 || m == 2 || m == 4
+                                    || (m == 3 && (n == 4 || n == 6 || n == 8)));
+            check(closedKnightTourExists(width, height) == expected, "feasibility",
+                  "Schwenk " + sizeName(width, height));
+        }
+    }
+
+    // solveFrom 不做预检查：定理说有解的尺寸搜索找到闭合回路；说无解的尺寸在 36 格以内穷举证明无解
+    for (int width = 1; width <= 10; width++) {
+        for (int height = 1; height <= 10; height++) {
+            const bool exists = closedKnightTourExists(width, height);
+            if (!exists && width * height > 36) {
+                continue;
+            }
+            TourOptions options;
+            options.width = width;
+            options.height = height;
+            options.closed = true;
+            const TourResult searched = KnightTourSolver(options).solveFrom({Square(0, 0)});
+            const bool agrees = exists ? searched.success
+                                             && TourValidator(width, height).validate(searched.path, true).ok()
+                                       : !searched.success && searched.stopReason == StopReason::Exhausted;
+            check(agrees, "feasibility", "Schwenk " + sizeName(width, height) + ": search says "
+                                             + stopReasonName(searched.stopReason));
+            if (!exists) {
+                check(checkTourFeasibility(options, Square(0, 0)) == Infeasibility::NoClosedTour, "feasibility",
+                      sizeName(width, height) + " closed should be NoClosedTour");
+            }
+        }
+    }
+
+    // 定理只适用于无障碍棋盘上的马
+    TourOptions holed;
+    holed.width = 5;
+    holed.height = 5;
+    holed.closed = true;
+    holed.obstacles.set(2 * 5 + 2);
+    check(checkTourFeasibility(holed, Square(0, 0)) != Infeasibility::NoClosedTour, "feasibility",
+          "Schwenk applied to a board with obstacles");
+    holed.obstacles.clear();
+    holed.leaper = LeaperType::Giraffe;
+    check(checkTourFeasibility(holed, Square(0, 0)) != Infeasibility::NoClosedTour, "feasibility",
+          "Schwenk applied to a giraffe");
+
+    TourOptions options;
+    options.width = 5;
+    options.height = 5;
+    options.closed = false;
+    check(checkTourFeasibility(options, Square(0, 0)) == Infeasibility::None, "feasibility", "5x5 open corner");
+    check(checkTourFeasibility(options, Square(0, 1)) == Infeasibility::ColorImbalance, "feasibility",
+          "5x5 open from the minority color");
+    check(checkTourFeasibility(options, Square(5, 0)) == Infeasibility::InvalidStart, "feasibility",
+          "start outside the board");
+    options.obstacles.set(0);
+    check(checkTourFeasibility(options, Square(0, 0)) == Infeasibility::InvalidStart, "feasibility",
+          "blocked start");
+
+    // 3x3 的中心格没有马步可达的邻居
+    TourOptions small;
+    small.width = 3;
+    small.height = 3;
+    small.closed = false;
+    check(checkTourFeasibility(small, Square(0, 0)) == Infeasibility::LowDegree, "feasibility",
+          "3x3 open: isolated center");
+
+    // 闭合回路：角上的格子只剩一条可用边（两个障碍颜色不同，两色仍然相等）
+    TourOptions corner;
+    corner.width = 6;
+    corner.height = 6;
+    corner.closed = true;
+    corner.obstacles.set(1 * 6 + 2);
+    corner.obstacles.set(2 * 6 + 2);
+    check(checkTourFeasibility(corner, Square(5, 5)) == Infeasibility::LowDegree, "feasibility",
+          "6x6 closed: corner with a single edge");
+
+    // 挡住相邻的两列：马一步最多跨两列，左右两部分不连通
+    TourOptions split;
+    split.width = 8;
+    split.height = 8;
+    for (bool closed : {false, true}) {
+        split.closed = closed;
+        for (int y = 0; y < 8; y++) {
+            split.obstacles.set(3 * 8 + y);
+            split.obstacles.set(4 * 8 + y);
+        }
+        check(checkTourFeasibility(split, Square(0, 0)) == Infeasibility::Disconnected, "feasibility",
+              std::string("8x8 split by two blocked columns") + (closed ? " (closed)" : " (open)"));
+    }
+
+    // 随机障碍：预检查判定无解时，完整搜索不能找到路径
+    std::srand(12345);
+    int rejected = 0;
+    for (int trial = 0; trial < 300; trial++) {
+        TourOptions random;
+        random.width = 4 + std::rand() % 2;
+        random.height = 4 + std::rand() % 2;
+        random.closed = std::rand() % 2 == 0;
+        const int obstacleCount = std::rand() % 4;
+        for (int i = 0; i < obstacleCount; i++) {
+            random.obstacles.set(std::rand() % (random.width * random.height));
+        }
+        const Square start(std::rand() % random.width, std::rand() % random.height);
+        const Infeasibility reason = checkTourFeasibility(random, start);
+        if (reason == Infeasibility::None || reason == Infeasibility::InvalidStart) {
+            continue;
+        }
+        rejected++;
+        const TourResult result = KnightTourSolver(random).solve(start);
+        check(!result.success, "feasibility",
+              "trial " + std::to_string(trial) + ": " + infeasibilityName(reason) + " but a tour exists");
+    }
+    check(rejected > 0, "feasibility", "no random case was rejected");
+}
@@ -0,0 +1,141 @@
+#include "knighttoursolver.h"
+#include "paralleltreesearch.h"
+#include "portfoliosolver.h"
+#include "testsupport.h"
+#include "tourvalidator.h"
+
+// 组合求解：各实例数下的第一条路径都有效、以起点开头；确定无解时与单线程求解的结论一致
+void testPortfolio()
+{
+    struct Case
+    {
+        int width;
+        int height;
+        bool closed;
+        Square start;
+    };
+    const Case cases[] = {
+        {5, 5, false, Square(0, 0)},
+        {6, 6, true, Square(1, 2)},
+        {8, 8, true, Square(3, 3)},
+        {9, 10, true, Square(0, 9)},
+        {12, 12, true, Square(5, 0)},
+        {7, 7, false, Square(6, 6)},
+    };
+    for (const Case& item : cases) {
+        TourOptions options;
+        options.width = item.width;
+        options.height = item.height;
+        options.closed = item.closed;
+        TourValidator validator(item.width, item.height);
+        for (int instances : {1, 2, 4}) {
+            PortfolioSolver portfolio(options, instances);
+            const TourResult result = portfolio.solve(item.start);
+            const std::string name = sizeName(item.width, item.height) + (item.closed ? " closed" : " open") + " x"
+                                     + std::to_string(instances);
+            check(result.success && result.stopReason == StopReason::Solved, "portfolio", name + ": not solved");
+            check(!result.path.empty() && result.path.front() == item.start
+                      && validator.validate(result.path, item.closed).ok(),
+                  "portfolio", name + ": invalid tour");
+            check(portfolio.lastWinner() >= 0 && portfolio.lastWinner() < instances, "portfolio",
+                  name + ": no winning instance");
+        }
+    }
+
+    // 需要搜索才能证明无解的情况：结论与单线程一致（4x4 开放路径不存在）
+    TourOptions small;
+    small.width = 4;
+    small.height = 4;
+    small.closed = false;
+    for (int x = 0; x < 4; x++) {
+        for (int y = 0; y < 4; y++) {
+            const TourResult serial = KnightTourSolver(small).solve(Square(x, y));
+            const TourResult parallel = PortfolioSolver(small, 3).solve(Square(x, y));
+            check(serial.stopReason == parallel.stopReason && serial.success == parallel.success, "portfolio",
+                  "4x4 open from " + std::to_string(x) + "," + std::to_string(y) + ": "
+                      + stopReasonName(serial.stopReason) + " vs " + stopReasonName(parallel.stopReason));
+        }
+    }
+}
+
+// 工作窃取并行搜索：第一条路径有效；全部路径计数与单线程枚举一致；
+// 拆分请求交出的子树与剩余搜索不重不漏
+void testParallelTreeSearch()
+{
+    struct Case
+    {
+        int width;
+        int height;
+        bool closed;
+        Square start;
+        long long tours; // 已知路径数（单线程枚举结果）
+    };
+    const Case cases[] = {
+        {5, 5, false, Square(0, 0), 304},
+        {5, 6, false, Square(0, 0), 4542},
+        {6, 6, true, Square(0, 0), 19724},
+    };
+    const auto countTours = [](const std::vector<Square>&) { return true; };
+
+    for (const Case& item : cases) {
+        TourOptions options;
+        options.width = item.width;
+        options.height = item.height;
+        options.closed = item.closed;
+        TourValidator validator(item.width, item.height);
+        const std::string name = sizeName(item.width, item.height) + (item.closed ? " closed" : " open");
+
+        const TourResult serial = KnightTourSolver(options).enumerateFrom({item.start}, countTours);
+        check(serial.stopReason == StopReason::Exhausted && serial.tourCount == item.tours, "parallel",
+              name + ": serial count " + std::to_string(serial.tourCount));
+
+        for (int threads : {1, 2, 4}) {
+            for (int depth : {0, 2, 4}) {
+                const std::string label = name + " threads " + std::to_string(threads) + " depth " + std::to_string(depth);
+
+                ParallelSearchOptions first;
+                first.threadCount = threads;
+                first.frontierDepth = depth;
+                first.mode = ParallelSearchMode::FirstSolution;
+                const TourResult found = ParallelTreeSearch(options, first).solve(item.start);
+                check(found.success && !found.path.empty() && found.path.front() == item.start
+                          && validator.validate(found.path, item.closed).ok(),
+                      "parallel", label + ": invalid first solution");
+
+                ParallelSearchOptions all = first;
+                all.mode = ParallelSearchMode::AllSolutions;
+                const TourResult counted = ParallelTreeSearch(options, all).solve(item.start);
+                check(counted.stopReason == StopReason::Exhausted && counted.tourCount == item.tours, "parallel",
+                      label + ": counted " + std::to_string(counted.tourCount));
+            }
+        }
+
+        // 每个检查点都请求拆分：剩余搜索的路径数加上各子树单独枚举的路径数应等于总数
+        std::vector<std::vector<Square>> donated;
+        KnightTourSolver solver(options);
+        const SplitCallback onSplit = [&](std::vector<Square>&& subtree) {
+            donated.push_back(std::move(subtree));
+            solver.requestSplit();
+        };
+        solver.setSplitCallback(&onSplit);
+        solver.requestSplit();
+        SearchBudget budget;
+        budget.checkInterval = 64;
+        const TourResult rest = solver.enumerateFrom({item.start}, countTours, budget);
+        long long total = rest.tourCount;
+        for (const std::vector<Square>& subtree : donated) {
+            check(subtree.size() >= 2 && subtree.front() == item.start, "parallel", name + ": malformed subtree");
+            total += KnightTourSolver(options).enumerateFrom(subtree, countTours).tourCount;
+        }
+        check(!donated.empty(), "parallel", name + ": no subtree donated");
+        check(rest.stopReason == StopReason::Exhausted && total == item.tours, "parallel",
+              name + ": split total " + std::to_string(total));
+    }
+
+    // 前缀无效（非马步相连）时不搜索
+    TourOptions options;
+    options.width = 6;
+    options.height = 6;
+    const TourResult invalid = ParallelTreeSearch(options).solveFrom({Square(0, 0), Square(1, 1)});
+    check(invalid.stopReason == StopReason::None && !invalid.success, "parallel", "invalid prefix searched");
+}
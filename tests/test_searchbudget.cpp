@@ -0,0 +1,74 @@
+#include <atomic>
+
+#include "knighttoursolver.h"
+#include "testsupport.h"
+
+// 搜索预算：节点上限精确生效（不受检查间隔影响），每种终止原因都如实报告
+void testSearchBudget()
+{
+    // 6x6 开放路径的完整枚举远超这些上限
+    TourOptions open;
+    open.width = 6;
+    open.height = 6;
+    open.closed = false;
+    const std::vector<Square> corner = {Square(0, 0)};
+    const TourCallback count = [](const std::vector<Square>&) { return true; };
+
+    for (long long limit : {1LL, 7LL, 100LL, 4095LL, 4096LL, 4097LL, 123457LL}) {
+        for (int interval : {1, 64, DEFAULT_BUDGET_CHECK_INTERVAL}) {
+            SearchBudget budget;
+            budget.timeLimitMs = 0;
+            budget.maxNodes = limit;
+            budget.checkInterval = interval;
+            const TourResult result = KnightTourSolver(open).enumerateFrom(corner, count, budget);
+            check(result.stopReason == StopReason::NodeLimit && result.nodes == limit, "budget",
+                  "limit " + std::to_string(limit) + " interval " + std::to_string(interval) + ": "
+                      + stopReasonName(result.stopReason) + " after " + std::to_string(result.nodes) + " nodes");
+        }
+    }
+
+    // 找到路径所需的节点数之内不受上限影响
+    TourOptions closed;
+    closed.width = 8;
+    closed.height = 8;
+    SearchBudget budget;
+    const TourResult solved = KnightTourSolver(closed).solve(Square(0, 0), budget);
+    check(solved.stopReason == StopReason::Solved && solved.success, "budget", "8x8 closed not solved");
+    budget.maxNodes = solved.nodes;
+    check(KnightTourSolver(closed).solve(Square(0, 0), budget).stopReason == StopReason::Solved, "budget",
+          "limit equal to the node count stops the search");
+    budget.maxNodes = solved.nodes - 1;
+    check(KnightTourSolver(closed).solve(Square(0, 0), budget).stopReason == StopReason::NodeLimit, "budget",
+          "limit one below the node count does not stop the search");
+
+    // 搜索穷尽（4x4 上没有开放路径，预检查无法排除，须搜索证明）
+    TourOptions small;
+    small.width = 4;
+    small.height = 4;
+    small.closed = false;
+    const TourResult exhausted = KnightTourSolver(small).solve(Square(0, 0));
+    check(exhausted.stopReason == StopReason::Exhausted && exhausted.nodes > 0 && !exhausted.success, "budget",
+          std::string("4x4 open: ") + stopReasonName(exhausted.stopReason));
+
+    // 超时（1ms 内不可能枚举完）
+    SearchBudget deadline;
+    deadline.timeLimitMs = 1;
+    deadline.checkInterval = 64;
+    const TourResult late = KnightTourSolver(open).enumerateFrom(corner, count, deadline);
+    check(late.stopReason == StopReason::Deadline, "budget", std::string("deadline: ") + stopReasonName(late.stopReason));
+
+    // 取消
+    std::atomic<bool> cancelled(true);
+    SearchBudget cancel;
+    cancel.timeLimitMs = 0;
+    cancel.cancelFlag = &cancelled;
+    cancel.checkInterval = 1;
+    const TourResult stopped = KnightTourSolver(open).enumerateFrom(corner, count, cancel);
+    check(stopped.stopReason == StopReason::Cancelled, "budget",
+          std::string("cancel: ") + stopReasonName(stopped.stopReason));
+
+    // 起点无效：未执行
+    const TourResult invalid = KnightTourSolver(closed).solve(Square(-1, 3));
+    check(invalid.stopReason == StopReason::None && invalid.nodes == 0, "budget",
+          std::string("invalid start: ") + stopReasonName(invalid.stopReason));
+}
@@ -0,0 +1,57 @@
+#include "structuredtour.h"
+#include "testsupport.h"
+#include "tourvalidator.h"
+
+// 构造式回路：每个受支持的尺寸、每个起点都是以起点开头的有效闭合回路；walk 与 solve 一致
+void testStructuredTour()
+{
+    for (int width = 6; width <= 20; width += 2) {
+        for (int height = width - 2; height <= width + 2; height += 2) {
+            if (!StructuredTour::isSupported(width, height)) {
+                continue;
+            }
+            const StructuredTour structured(width, height);
+            TourValidator validator(width, height);
+            const std::string name = sizeName(width, height);
+            int invalid = 0;
+            for (int x = 0; x < width; x++) {
+                for (int y = 0; y < height; y++) {
+                    const TourResult result = structured.solve(Square(x, y));
+                    invalid += !result.success || result.path.front() != Square(x, y)
+                               || !validator.validate(result.path, true).ok();
+                }
+            }
+            check(invalid == 0, "structured", name + ": " + std::to_string(invalid) + " invalid starts");
+
+            const Square start(width / 2, 1);
+            const std::vector<Square> path = structured.solve(start).path;
+            size_t index = 0;
+            bool same = true;
+            const long long walked = structured.walk(start, [&](const Square& sq) {
+                same = same && index < path.size() && path[index] == sq;
+                index++;
+                return true;
+            });
+            check(same && walked == structured.squareCount(), "structured", name + ": walk differs from solve");
+        }
+    }
+
+    // 大棋盘只抽查几个起点
+    for (const Square& size : {Square(100, 100), Square(98, 100)}) {
+        const StructuredTour structured(size.x, size.y);
+        TourValidator validator(size.x, size.y);
+        for (const Square& start : {Square(0, 0), Square(size.x / 2, size.y / 3), Square(size.x - 1, size.y - 1)}) {
+            const TourResult result = structured.solve(start);
+            check(result.success && result.path.front() == start && validator.validate(result.path, true).ok(),
+                  "structured", sizeName(size.x, size.y) + ": invalid tour");
+        }
+    }
+
+    check(!StructuredTour::isSupported(7, 7) && !StructuredTour::isSupported(6, 10)
+              && !StructuredTour::isSupported(4, 4),
+          "structured", "unsupported sizes reported as supported");
+    check(StructuredTour(7, 7).solve(Square(0, 0)).stopReason == StopReason::None, "structured",
+          "unsupported size should return None");
+    check(StructuredTour(8, 8).solve(Square(8, 0)).stopReason == StopReason::None, "structured",
+          "start outside the board should return None");
+}
@@ -0,0 +1,81 @@
+#include "knighttoursolver.h"
+#include "portfoliosolver.h"
+#include "testsupport.h"
+#include "tourcache.h"
+#include "tourvalidator.h"
+
+namespace {
+
+std::vector<Square> closedTour(int width, int height)
+{
+    TourOptions options;
+    options.width = width;
+    options.height = height;
+    options.closed = true;
+    return KnightTourSolver(options).solve(Square(0, 0)).path;
+}
+
+} // namespace
+
+// 回路缓存：每个起点、每个变体（含转置尺寸的查询）都是以起点开头的有效闭合回路，变体两两不同；
+// 组合求解命中缓存时不启动实例
+void testTourCache()
+{
+    for (const Square& size : {Square(6, 6), Square(6, 8), Square(10, 8)}) {
+        TourCache cache;
+        check(cache.store(size.x, size.y, closedTour(size.x, size.y)), "cache",
+              sizeName(size.x, size.y) + ": store failed");
+
+        for (const Square& query : {size, Square(size.y, size.x)}) {
+            const std::string name = sizeName(query.x, query.y) + " from " + sizeName(size.x, size.y);
+            const int variants = TourCache::variantCount(query.x, query.y);
+            check(variants == (query.x == query.y ? 16 : 8), "cache", name + ": variant count");
+            TourValidator validator(query.x, query.y);
+            int invalid = 0;
+            int duplicates = 0;
+            for (int x = 0; x < query.x; x++) {
+                for (int y = 0; y < query.y; y++) {
+                    std::vector<std::vector<Square>> seen;
+                    for (int variant = 0; variant < variants; variant++) {
+                        std::vector<Square> path;
+                        if (!cache.lookup(query.x, query.y, Square(x, y), variant, path)
+                            || path.front() != Square(x, y) || !validator.validate(path, true).ok()) {
+                            invalid++;
+                            continue;
+                        }
+                        for (const std::vector<Square>& other : seen) {
+                            duplicates += other == path;
+                        }
+                        seen.push_back(path);
+                    }
+                }
+            }
+            check(invalid == 0, "cache", name + ": " + std::to_string(invalid) + " invalid lookups");
+            check(duplicates == 0, "cache", name + ": " + std::to_string(duplicates) + " repeated variants");
+        }
+    }
+
+    TourCache cache;
+    std::vector<Square> path;
+    check(!cache.lookup(8, 8, Square(0, 0), 0, path), "cache", "lookup hit on an empty cache");
+    std::vector<Square> open = closedTour(8, 8);
+    std::swap(open[10], open[20]);
+    check(!cache.store(8, 8, open), "cache", "stored a path that is not a closed tour");
+
+    // 组合求解：第一次求解保存获胜回路，之后其他起点直接由缓存给出；开放路径不使用缓存
+    TourOptions options;
+    options.width = 8;
+    options.height = 8;
+    options.closed = true;
+    PortfolioSolver portfolio(options, 2);
+    portfolio.setTourCache(&cache);
+    const TourResult first = portfolio.solve(Square(0, 0));
+    check(first.success && !first.fromCache && cache.contains(8, 8), "cache", "portfolio result not stored");
+    const TourResult cached = portfolio.solve(Square(3, 4));
+    check(cached.success && cached.fromCache && cached.nodes == 0 && portfolio.lastWinner() == -1
+              && cached.path.front() == Square(3, 4) && TourValidator(8, 8).validate(cached.path, true).ok(),
+          "cache", "portfolio did not answer from the cache");
+    options.closed = false;
+    portfolio.setOptions(options);
+    check(!portfolio.solve(Square(3, 4)).fromCache, "cache", "open tour answered from the closed cache");
+}
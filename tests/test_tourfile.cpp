@@ -0,0 +1,123 @@
+#include <cstdio>
+
+#include "knighttoursolver.h"
+#include "structuredtour.h"
+#include "testsupport.h"
+#include "tourfile.h"
+
+namespace {
+
+const char* const TOUR_FILE_NAME = "knighttourtests.ktr";
+
+struct FileCase
+{
+    std::vector<Square> path;
+    int width;
+    int height;
+    LeaperType leaper;
+    int chunkSize;
+    bool closed;
+};
+
+// 写入后顺序解码、随机访问、从已知格子开始的游标与展开都得到原路径，文件头各项正确
+void checkTourFile(const FileCase& item)
+{
+    const std::string name = sizeName(item.width, item.height) + " " + leaperName(item.leaper) + " chunk "
+                             + std::to_string(item.chunkSize);
+    check(!item.path.empty(), "tourfile", name + ": no path to write");
+    if (item.path.empty()) {
+        return;
+    }
+
+    TourFileWriter writer(item.chunkSize);
+    bool written = writer.open(TOUR_FILE_NAME, item.width, item.height, item.leaper);
+    for (const Square& sq : item.path) {
+        written = written && writer.append(sq);
+    }
+    written = written && writer.finish();
+    check(written, "tourfile", name + ": write failed: " + writer.errorString());
+
+    TourFile file;
+    check(file.open(TOUR_FILE_NAME), "tourfile", name + ": open failed: " + file.errorString());
+    if (!file.isOpen()) {
+        return;
+    }
+    check(file.width() == item.width && file.height() == item.height, "tourfile", name + ": size");
+    check(file.leaper() == item.leaper, "tourfile", name + ": leaper");
+    check(file.length() == static_cast<long long>(item.path.size()), "tourfile", name + ": length");
+    check(file.isClosed() == item.closed, "tourfile", name + ": closed flag");
+
+    bool sequential = true;
+    TourFile::Cursor cursor = file.cursor();
+    long long steps = 0;
+    do {
+        sequential = sequential && cursor.square() == item.path[steps];
+        steps++;
+    } while (cursor.next());
+    check(sequential && steps == file.length(), "tourfile", name + ": cursor");
+
+    bool random = true;
+    for (size_t i = 0; i < item.path.size(); i += 7) {
+        random = random && file.at(static_cast<long long>(i)) == item.path[i];
+    }
+    random = random && file.at(file.length() - 1) == item.path.back();
+    check(random, "tourfile", name + ": at()");
+
+    // 从中间已知的格子继续解码（界面的分段索引按这种方式读取可见的段）
+    const long long middle = file.length() / 2;
+    TourFile::Cursor resumed = file.cursor(middle, item.path[middle]);
+    bool tail = true;
+    while (resumed.next()) {
+        tail = tail && resumed.square() == item.path[resumed.step()];
+    }
+    check(tail && resumed.step() == file.length() - 1, "tourfile", name + ": cursor from a known square");
+
+    std::vector<Square> path;
+    check(file.toPath(path) && path == item.path, "tourfile", name + ": toPath");
+}
+
+} // namespace
+
+// 路径文件：各种索引间隔（含无索引）、闭合与开放路径都能原样读回；非法的一步不能写入
+void testTourFile()
+{
+    checkTourFile({StructuredTour(8, 8).solve(Square(3, 4)).path, 8, 8, LeaperType::Knight, 8, true});
+    checkTourFile({StructuredTour(30, 32).solve(Square(0, 0)).path, 30, 32, LeaperType::Knight,
+                   DEFAULT_TOUR_FILE_CHUNK, true});
+    checkTourFile({StructuredTour(10, 10).solve(Square(9, 9)).path, 10, 10, LeaperType::Knight, 0, true});
+    checkTourFile({StructuredTour(200, 202).solve(Square(17, 5)).path, 200, 202, LeaperType::Knight, 64, true});
+
+    TourOptions open;
+    open.width = 5;
+    open.height = 5;
+    open.closed = false;
+    checkTourFile({KnightTourSolver(open).solve(Square(0, 0)).path, 5, 5, LeaperType::Knight, 16, false});
+
+    // 其他跳子：挡住走不到的格子后求解（文件不记录障碍，没有走遍整个棋盘的路径不标记为闭合）
+    for (const Square& size : {Square(6, 6), Square(5, 5)}) {
+        const LeaperType leaper = size.x == 6 ? LeaperType::Camel : LeaperType::Giraffe;
+        TourOptions options;
+        options.width = size.x;
+        options.height = size.y;
+        options.closed = false;
+        options.leaper = leaper;
+        options.obstacles = leaperObstacles(size.x, size.y, leaper);
+        std::vector<Square> path;
+        for (int index = 0; index < size.x * size.y && path.empty(); index++) {
+            if (!options.obstacles.test(index)) {
+                path = KnightTourSolver(options).solve(Square(index / size.y, index % size.y)).path;
+            }
+        }
+        checkTourFile({path, size.x, size.y, leaper, 4, false});
+    }
+
+    TourFileWriter writer;
+    writer.open(TOUR_FILE_NAME, 8, 8);
+    writer.append(Square(0, 0));
+    check(!writer.append(Square(1, 1)), "tourfile", "illegal step accepted");
+    check(!writer.append(Square(-2, 1)), "tourfile", "square outside the board accepted");
+    writer.open(TOUR_FILE_NAME, 8, 8, LeaperType::Camel);
+    writer.append(Square(0, 0));
+    check(!writer.append(Square(1, 2)), "tourfile", "knight step accepted for a camel");
+    std::remove(TOUR_FILE_NAME);
+}
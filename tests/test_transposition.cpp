@@ -0,0 +1,104 @@
+#include "knighttoursolver.h"
+#include "testsupport.h"
+#include "tourenumerator.h"
+#include "tourvalidator.h"
+#include "transpositiontable.h"
+
+// 无解状态表：只剪掉已证明无解的状态，枚举计数与不用表时一致；命中与写入计入统计；
+// 不同尺寸、障碍布局共用一张表时互不干扰
+void testTranspositionTable()
+{
+    struct Case
+    {
+        int width;
+        int height;
+        bool closed;
+        bool wholeBoard;
+        int threads;
+    };
+    const Case cases[] = {
+        {5, 5, false, false, 1},
+        {5, 6, false, false, 1},
+        {4, 5, false, true, 1},
+        {5, 6, true, true, 1},
+        {6, 6, true, false, 1},
+        {5, 6, false, false, 2},
+    };
+
+    // 所有情形共用一张表：键里带有尺寸、是否闭合与起点的盐
+    TranspositionTable shared(16);
+    for (const Case& item : cases) {
+        TourOptions options;
+        options.width = item.width;
+        options.height = item.height;
+        options.closed = item.closed;
+        ParallelSearchOptions parallel;
+        parallel.threadCount = item.threads;
+        const std::string name = sizeName(item.width, item.height) + (item.closed ? " closed" : " open")
+                                 + (item.wholeBoard ? "" : " corner") + " x" + std::to_string(item.threads);
+
+        TourEnumerator plain(options, parallel);
+        const TourResult expected =
+            item.wholeBoard ? plain.enumerateBoard() : plain.enumerateFrom(Square(0, 0));
+
+        TranspositionTable table(16);
+        for (TranspositionTable* used : {&table, &shared}) {
+            const long long hitsBefore = used->hits();
+            const long long storesBefore = used->stores();
+            TourEnumerator enumerator(options, parallel);
+            enumerator.setTranspositionTable(used);
+            const TourResult result =
+                item.wholeBoard ? enumerator.enumerateBoard() : enumerator.enumerateFrom(Square(0, 0));
+            const std::string label = name + (used == &shared ? " (shared table)" : " (table)");
+            check(result.stopReason == StopReason::Exhausted && result.tourCount == expected.tourCount,
+                  "transposition", label + ": " + std::to_string(result.tourCount) + " tours, expected "
+                                       + std::to_string(expected.tourCount));
+            check(used->hits() > hitsBefore && used->stores() > storesBefore, "transposition",
+                  label + ": hits/stores not counted");
+        }
+        check(expected.nodes > 0, "transposition", name + ": no nodes without table");
+    }
+
+    // 单线程求解器：枚举计数一致；有障碍的棋盘与无障碍的共用表时按暴力枚举计数
+    TourOptions options;
+    options.width = 5;
+    options.height = 5;
+    options.closed = false;
+    TranspositionTable table(4);
+    for (bool withObstacle : {false, true}) {
+        options.obstacles.clear();
+        if (withObstacle) {
+            options.obstacles.set(1 * 5 + 2);
+        }
+        const long long expected = bruteForceCount(options, Square(0, 0));
+        KnightTourSolver solver(options);
+        solver.setTranspositionTable(&table);
+        const TourResult result = solver.enumerateFrom({Square(0, 0)}, [](const std::vector<Square>&) {
+            return true;
+        });
+        check(result.stopReason == StopReason::Exhausted && result.tourCount == expected, "transposition",
+              std::string("solver 5x5") + (withObstacle ? " with obstacle" : "") + ": "
+                  + std::to_string(result.tourCount) + " tours, expected " + std::to_string(expected));
+    }
+
+    // 第一条解：带表求解的路径有效；重复求解命中已写入的状态
+    TourOptions closed;
+    closed.width = 6;
+    closed.height = 6;
+    closed.closed = true;
+    closed.forwardChecking = false;
+    TranspositionTable firstTable(4);
+    TourValidator validator(6, 6);
+    KnightTourSolver solver(closed);
+    solver.setTranspositionTable(&firstTable);
+    for (int round = 0; round < 2; round++) {
+        const TourResult result = solver.solve(Square(0, 1));
+        check(result.success && validator.validate(result.path, true).ok(), "transposition",
+              "6x6 closed first solution invalid (round " + std::to_string(round) + ")");
+    }
+    check(firstTable.hits() > 0, "transposition", "6x6 closed: repeated solve had no table hits");
+
+    firstTable.clear();
+    check(firstTable.hits() == 0 && firstTable.stores() == 0 && firstTable.misses() == 0, "transposition",
+          "clear should reset the counters");
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+
+#include "knighttoursolver.h"
+#include "structuredtour.h"
+#include "testsupport.h"
+#include "tourvalidator.h"
+
+namespace {
+
+// 逐格的标量参照：与校验器相同的分块顺序（每块先查格子与走法，再查重复），不用 SIMD 与位集合
+TourCheck referenceCheck(const std::vector<Square>& path, int width, int height,
+                         const std::set<std::pair<int, int>>& blocked, bool closed)
+{
+    TourCheck check;
+    if (path.empty() || static_cast<long long>(path.size()) != static_cast<long long>(width) * height
+                                                                    - static_cast<long long>(blocked.size())) {
+        check.defect = TourDefect::WrongLength;
+        return check;
+    }
+    const TourValidator leaps(width, height);
+    std::set<std::pair<int, int>> visited;
+    for (size_t begin = 0; begin < path.size(); begin += TourValidator::VALIDATE_BLOCK) {
+        const size_t end = std::min(begin + TourValidator::VALIDATE_BLOCK, path.size());
+        for (size_t i = begin; i < end; i++) {
+            const Square& sq = path[i];
+            if (sq.x < 0 || sq.x >= width || sq.y < 0 || sq.y >= height) {
+                check.defect = TourDefect::OutOfBoard;
+                check.index = static_cast<long long>(i);
+                return check;
+            }
+            if (i + 1 < path.size() && !leaps.isLeap(sq, path[i + 1])) {
+                check.defect = TourDefect::IllegalMove;
+                check.index = static_cast<long long>(i);
+                return check;
+            }
+        }
+        for (size_t i = begin; i < end; i++) {
+            const std::pair<int, int> cell(path[i].x, path[i].y);
+            if (blocked.count(cell) || !visited.insert(cell).second) {
+                check.defect = blocked.count(cell) ? TourDefect::Blocked : TourDefect::Revisited;
+                check.index = static_cast<long long>(i);
+                return check;
+            }
+        }
+    }
+    if (closed && !leaps.isLeap(path.back(), path.front())) {
+        check.defect = TourDefect::NotClosed;
+        check.index = static_cast<long long>(path.size() - 1);
+    }
+    return check;
+}
+
+} // namespace
+
+// 校验器：随机破坏的长路径（跨越多个块）与标量参照的结论、出错位置一致；
+// 障碍格子不计入长度，经过障碍、重复访问、非法走法、未闭合分别报告
+void testValidator()
+{
+    std::mt19937 random(2024);
+    for (const Square& size : {Square(8, 8), Square(64, 66), Square(100, 100)}) {
+        const std::vector<Square> tour = StructuredTour(size.x, size.y).solve(Square(1, 0)).path;
+        TourValidator validator(size.x, size.y);
+        const std::string name = sizeName(size.x, size.y);
+        check(validator.validate(tour, true).ok(), "validator", name + ": valid tour rejected");
+
+        int mismatches = 0;
+        std::vector<std::vector<Square>> batch;
+        for (int trial = 0; trial < 200; trial++) {
+            std::vector<Square> path = tour;
+            std::uniform_int_distribution<size_t> anyIndex(0, path.size() - 1);
+            const size_t i = anyIndex(random);
+            const size_t j = anyIndex(random);
+            switch (trial % 5) {
+            case 0: std::swap(path[i], path[j]); break;                                 // 非法走法
+            case 1: path[i] = path[j]; break;                                           // 重复访问
+            case 2: path[i].x = (trial % 2) ? -1 - path[i].x : size.x + path[i].y; break; // 棋盘外
+            case 3: std::reverse(path.begin() + std::min(i, j), path.begin() + std::max(i, j)); break;
+            case 4: path.erase(path.begin() + i); break;                               // 长度错误
+            }
+            const TourCheck expected = referenceCheck(path, size.x, size.y, {}, true);
+            const TourCheck actual = validator.validate(path, true);
+            mismatches += actual.defect != expected.defect || actual.index != expected.index;
+            batch.push_back(std::move(path));
+        }
+        check(mismatches == 0, "validator",
+              name + ": " + std::to_string(mismatches) + " results differ from reference");
+
+        const std::vector<TourCheck> results = validator.validateBatch(batch, true);
+        bool same = results.size() == batch.size();
+        for (size_t k = 0; same && k < batch.size(); k++) {
+            const TourCheck single = validator.validate(batch[k], true);
+            same = results[k].defect == single.defect && results[k].index == single.index;
+        }
+        check(same, "validator", name + ": batch differs from single validation");
+    }
+
+    TourOptions options;
+    options.width = 5;
+    options.height = 5;
+    options.closed = false;
+    options.obstacles.set(2 * 5 + 2);
+    const TourResult result = KnightTourSolver(options).solve(Square(0, 0));
+    check(result.success, "validator", "5x5 open with a centre obstacle has no tour");
+    if (!result.success) {
+        return;
+    }
+
+    TourValidator validator(5, 5, LeaperType::Knight, options.obstacles);
+    check(validator.validate(result.path, false).ok(), "validator", "valid tour with an obstacle rejected");
+    check(TourValidator(5, 5).validate(result.path, false).defect == TourDefect::WrongLength, "validator",
+          "tour with an obstacle accepted without the mask");
+
+    // 把一个前后两步都能到达中心的格子换成中心（障碍）：走法合法、不重复，只能报告 Blocked
+    const Square centre(2, 2);
+    bool replaced = false;
+    for (size_t i = 0; i < result.path.size() && !replaced; i++) {
+        if ((i == 0 || validator.isLeap(result.path[i - 1], centre))
+            && (i + 1 == result.path.size() || validator.isLeap(centre, result.path[i + 1]))) {
+            std::vector<Square> path = result.path;
+            path[i] = centre;
+            const TourCheck blocked = validator.validate(path, false);
+            check(blocked.defect == TourDefect::Blocked && blocked.index == static_cast<long long>(i), "validator",
+                  "path through an obstacle not reported as blocked");
+            replaced = true;
+        }
+    }
+    check(replaced, "validator", "no square could be replaced by the obstacle");
+
+    // 5x5 上没有闭合回路，任何开放路径都不闭合
+    options.obstacles.clear();
+    const TourResult open = KnightTourSolver(options).solve(Square(0, 0));
+    const TourCheck notClosed = TourValidator(5, 5).validate(open.path, true);
+    check(open.success && notClosed.defect == TourDefect::NotClosed && notClosed.index == 24, "validator",
+          "open 5x5 tour accepted as closed");
+}
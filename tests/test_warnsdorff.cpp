@@ -0,0 +1,104 @@
+#include "testsupport.h"
+#include "tourvalidator.h"
+#include "warnsdorfftour.h"
+
+namespace {
+
+constexpr TieBreak TIE_BREAKS[] = {TieBreak::Index, TieBreak::Pohl, TieBreak::FixedOrder, TieBreak::Roth};
+
+// 每种辅助规则的最少成功起点数（与 TIE_BREAKS 顺序一致），低于下限说明规则或闭合回路的尾部预留退化
+struct Case
+{
+    int size;
+    bool closed;
+    int stride;          // 每隔 stride 个格子取一个起点（按坐标序号）
+    int minSolved[4];
+};
+
+} // namespace
+
+// 无回溯的 Warnsdorff：各辅助规则在各尺寸上的成功率不低于下限；成功时为以起点开头的有效路径，
+// 失败时明确报告 DeadEnd（不返回半截路径）
+void testWarnsdorff()
+{
+    const Case cases[] = {
+        {8, false, 1, {60, 63, 62, 64}},
+        {8, true, 1, {48, 60, 51, 64}},
+        {20, false, 1, {390, 396, 392, 398}},
+        {20, true, 1, {330, 385, 335, 360}},
+        {50, false, 7, {310, 295, 350, 355}},
+        {50, true, 7, {245, 300, 285, 315}},
+    };
+    for (const Case& c : cases) {
+        TourOptions options;
+        options.width = c.size;
+        options.height = c.size;
+        options.closed = c.closed;
+        TourValidator validator(c.size, c.size);
+        const std::string name = sizeName(c.size, c.size) + (c.closed ? " closed" : " open");
+        for (int rule = 0; rule < 4; rule++) {
+            WarnsdorffTour greedy(options, TIE_BREAKS[rule]);
+            const std::string label = name + " " + tieBreakName(TIE_BREAKS[rule]);
+            int starts = 0;
+            int solved = 0;
+            int invalid = 0;
+            int badFailures = 0;
+            for (int index = 0; index < c.size * c.size; index += c.stride) {
+                const Square start(index / c.size, index % c.size);
+                const TourResult result = greedy.solve(start);
+                starts++;
+                if (result.success) {
+                    solved++;
+                    invalid += result.stopReason != StopReason::Solved || result.path.front() != start
+                               || !validator.validate(result.path, c.closed).ok();
+                } else {
+                    badFailures += result.stopReason != StopReason::DeadEnd || !result.path.empty()
+                                   || result.tourCount != 0 || result.nodes <= 0
+                                   || result.nodes >= c.size * c.size;
+                }
+            }
+            check(solved >= c.minSolved[rule], "warnsdorff",
+                  label + ": " + std::to_string(solved) + "/" + std::to_string(starts) + " solved, expected at least "
+                      + std::to_string(c.minSolved[rule]));
+            check(invalid == 0, "warnsdorff", label + ": " + std::to_string(invalid) + " invalid tours");
+            check(badFailures == 0, "warnsdorff", label + ": " + std::to_string(badFailures)
+                                                      + " failures not reported as DeadEnd");
+        }
+    }
+
+    // 有障碍的棋盘上尾部预留同样成立（两个障碍颜色不同，闭合回路存在）
+    TourOptions blocked;
+    blocked.width = 10;
+    blocked.height = 10;
+    blocked.closed = true;
+    blocked.obstacles.set(4 * 10 + 4);
+    blocked.obstacles.set(4 * 10 + 5);
+    TourValidator blockedValidator(10, 10, LeaperType::Knight, blocked.obstacles);
+    WarnsdorffTour blockedGreedy(blocked, TieBreak::Roth);
+    int blockedSolved = 0;
+    int blockedInvalid = 0;
+    for (int x = 0; x < 10; x++) {
+        for (int y = 0; y < 10; y++) {
+            if (blocked.obstacles.test(x * 10 + y)) {
+                continue;
+            }
+            const TourResult result = blockedGreedy.solve(Square(x, y));
+            blockedSolved += result.success;
+            blockedInvalid += result.success ? !blockedValidator.validate(result.path, true).ok()
+                                             : result.stopReason != StopReason::DeadEnd;
+        }
+    }
+    check(blockedSolved >= 75 && blockedInvalid == 0, "warnsdorff",
+          "10x10 with obstacles: " + std::to_string(blockedSolved) + " solved, "
+              + std::to_string(blockedInvalid) + " invalid");
+
+    TourOptions small;
+    small.width = 4;
+    small.height = 4;
+    small.closed = true;
+    const TourResult impossible = WarnsdorffTour(small, TieBreak::Roth).solve(Square(0, 0));
+    check(!impossible.success && impossible.stopReason == StopReason::DeadEnd && impossible.path.empty(),
+          "warnsdorff", "4x4 closed should end in DeadEnd");
+    check(WarnsdorffTour(small).solve(Square(4, 0)).stopReason == StopReason::None, "warnsdorff",
+          "start outside the board should return None");
+}
@@ -0,0 +1,29 @@
+# 引擎自检（命令行程序，不依赖 Qt）：与暴力枚举、已知结论对照，任一检查失败时返回非零
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+TARGET = knighttourtests
+
+# 求解引擎静态库
+include(../engine/engine.pri)
+
+HEADERS += \
+    testsupport.h
+
+SOURCES += \
+    main.cpp \
+    testsupport.cpp \
+    test_engine.cpp \
+    test_cancellation.cpp \
+    test_bitboard.cpp \
+    test_searchbudget.cpp \
+    test_parallel.cpp \
+    test_tourcache.cpp \
+    test_structured.cpp \
+    test_enumeration.cpp \
+    test_tourfile.cpp \
+    test_validator.cpp \
+    test_warnsdorff.cpp \
+    test_transposition.cpp \
+    test_feasibility.cpp
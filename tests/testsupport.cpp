@@ -0,0 +1,108 @@
+#include "testsupport.h"
+
+#include <cstdio>
+
+#include "leaper.h"
+
+namespace {
+
+int g_checks = 0;
+int g_failures = 0;
+
+long long bruteForceCount(const TourOptions& options, std::vector<bool>& visited, const Square& start, int x, int y,
+                          int depth)
+{
+    if (depth == options.squareCount()) {
+        if (!options.closed) {
+            return 1;
+        }
+        for (const MoveDelta& move : leaperDirections(options.leaper)) {
+            if (x + move.dx == start.x && y + move.dy == start.y) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+    long long count = 0;
+    for (const MoveDelta& move : leaperDirections(options.leaper)) {
+        const int nx = x + move.dx;
+        const int ny = y + move.dy;
+        if (nx < 0 || nx >= options.width || ny < 0 || ny >= options.height) {
+            continue;
+        }
+        const int index = nx * options.height + ny;
+        if (visited[index] || options.obstacles.test(index)) {
+            continue;
+        }
+        visited[index] = true;
+        count += bruteForceCount(options, visited, start, nx, ny, depth + 1);
+        visited[index] = false;
+    }
+    return count;
+}
+
+} // namespace
+
+void check(bool condition, const char* group, const std::string& what)
+{
+    g_checks++;
+    if (!condition) {
+        g_failures++;
+        std::printf("FAIL [%s] %s\n", group, what.c_str());
+    }
+}
+
+int checkCount()
+{
+    return g_checks;
+}
+
+int failureCount()
+{
+    return g_failures;
+}
+
+std::string sizeName(int width, int height)
+{
+    return std::to_string(width) + "x" + std::to_string(height);
+}
+
+long long bruteForceCount(const TourOptions& options, const Square& start)
+{
+    std::vector<bool> visited(options.width * options.height, false);
+    visited[start.x * options.height + start.y] = true;
+    return bruteForceCount(options, visited, start, start.x, start.y, 1);
+}
+
+long long bruteForceBoardCount(const TourOptions& options)
+{
+    long long count = 0;
+    for (int x = 0; x < options.width; x++) {
+        for (int y = 0; y < options.height; y++) {
+            if (!options.obstacles.test(x * options.height + y)) {
+                count += bruteForceCount(options, Square(x, y));
+            }
+        }
+    }
+    return count;
+}
+
+ObstacleMask leaperObstacles(int width, int height, LeaperType leaper)
+{
+    ObstacleMask obstacles;
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+            bool reachable = false;
+            for (const MoveDelta& move : leaperDirections(leaper)) {
+                const int nx = x + move.dx;
+                const int ny = y + move.dy;
+                reachable = reachable || (nx >= 0 && nx < width && ny >= 0 && ny < height);
+            }
+            const bool otherColor = leaper == LeaperType::Camel && (x + y) % 2 == 1;
+            if (!reachable || otherColor) {
+                obstacles.set(x * height + y);
+            }
+        }
+    }
+    return obstacles;
+}
@@ -0,0 +1,58 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include <string>
+#include <vector>
+
+#include "tourtypes.h"
+
+// 引擎自检的公共部分：检查计数与失败输出、与独立实现对照用的暴力枚举
+
+/**
+ * @brief 记录一次检查，失败时输出分组与说明
+ */
+void check(bool condition, const char* group, const std::string& what);
+
+/**
+ * @brief 已执行的检查数与失败数
+ */
+int checkCount();
+int failureCount();
+
+/**
+ * @brief 尺寸的文本表示（"5x6"）
+ */
+std::string sizeName(int width, int height);
+
+/**
+ * @brief 暴力枚举（不剪枝、不用对称）：从 start 出发的有向路径数（closed 时只计能回到起点的）
+ */
+long long bruteForceCount(const TourOptions& options, const Square& start);
+
+/**
+ * @brief 暴力枚举整个棋盘（所有非障碍起点）的有向路径数
+ */
+long long bruteForceBoardCount(const TourOptions& options);
+
+/**
+ * @brief 跳子在棋盘上走不到的格子：一步也到不了的格子；骆驼不改变格子颜色，另一色的格子也算在内
+ */
+ObstacleMask leaperObstacles(int width, int height, LeaperType leaper);
+
+// 各组检查（按被检查的模块分文件）
+void testEngine();
+void testCancellation();
+void testBitboard();
+void testSearchBudget();
+void testPortfolio();
+void testParallelTreeSearch();
+void testTourCache();
+void testStructuredTour();
+void testEnumeration();
+void testTourFile();
+void testValidator();
+void testWarnsdorff();
+void testTranspositionTable();
+void testFeasibility();
+
+#endif // TESTSUPPORT_H